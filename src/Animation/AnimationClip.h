@@ -0,0 +1,579 @@
+#ifndef _Animation_AnimationClip_H
+#define _Animation_AnimationClip_H
+
+#include <Animation/Skinning.h>
+#include <HelperGl/LoaderOgre3D.h>
+#include <Math/Quaternion.h>
+#include <Math/Vectorf.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cassert>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	AnimationClip
+	///
+	/// \brief	A compressed animation of a skeleton, sampled at a fixed rate. The clip is cut in
+	/// 		segments of a fixed number of frames, each segment stores the keys of all the bones
+	/// 		contiguously (bone after bone) with a key on its first and last frames: sampling a time
+	/// 		reads one segment in one linear pass, without search in the whole clip. Inside a
+	/// 		segment, the keys which can be interpolated from their neighbours within the tolerances
+	/// 		are removed (a constant track keeps one key). Rotations are quantized with the smallest
+	/// 		three encoding (index of the largest component in 2 bits, the three other components on
+	/// 		15 bits each, 6 bytes), translations on 16 bits per component in the range of their bone.
+	/// 		The clip is read only once built: it can be sampled concurrently by many characters.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class AnimationClip
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	QuantizedVector
+		///
+		/// \brief	A quantized rotation or translation.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct QuantizedVector
+		{
+			::std::uint16_t m_components[3] ;
+		};
+
+	protected:
+		/// \brief	The number of bones.
+		size_t m_bones ;
+		/// \brief	The number of frames.
+		size_t m_frames ;
+		/// \brief	The number of frames per second.
+		float m_rate ;
+		/// \brief	The number of frames per segment.
+		unsigned int m_segmentFrames ;
+		/// \brief	The number of segments.
+		size_t m_segments ;
+		/// \brief	The first rotation key of each segment / bone (segment major, one more value at the end).
+		::std::vector<::std::uint32_t> m_rotationStart ;
+		/// \brief	The frame of each rotation key relative to the beginning of its segment.
+		::std::vector<::std::uint8_t> m_rotationFrames ;
+		/// \brief	The rotation keys.
+		::std::vector<QuantizedVector> m_rotations ;
+		/// \brief	The first translation key of each segment / bone (segment major, one more value at the end).
+		::std::vector<::std::uint32_t> m_translationStart ;
+		/// \brief	The frame of each translation key relative to the beginning of its segment.
+		::std::vector<::std::uint8_t> m_translationFrames ;
+		/// \brief	The translation keys.
+		::std::vector<QuantizedVector> m_translations ;
+		/// \brief	The minimum translation of each bone.
+		::std::vector<Math::Vector3f> m_translationOrigins ;
+		/// \brief	The quantization step of the translations of each bone.
+		::std::vector<Math::Vector3f> m_translationSteps ;
+
+		/// \brief	The scale of the smallest three components (1/sqrt(2) is mapped to 32767).
+		static float smallestThreeScale()
+		{
+			return 32767.0f/(2.0f*0.70710678f) ;
+		}
+
+		static void toArray(const Math::Quaternion<float> & quaternion, float * result)
+		{
+			result[0] = quaternion.s() ;
+			result[1] = quaternion.v()[0] ;
+			result[2] = quaternion.v()[1] ;
+			result[3] = quaternion.v()[2] ;
+		}
+
+		/// \brief	Normalized linear interpolation of two quaternions (w, x, y, z) on the shortest path.
+		static void nlerp(const float * q0, const float * q1, float t, float * result)
+		{
+			float dot = q0[0]*q1[0]+q0[1]*q1[1]+q0[2]*q1[2]+q0[3]*q1[3] ;
+			float t1 = (dot<0.0f) ? -t : t ;
+			float t0 = 1.0f-t ;
+			for(int cpt=0 ; cpt<4 ; ++cpt) { result[cpt] = q0[cpt]*t0+q1[cpt]*t1 ; }
+			float inverse = 1.0f/::std::sqrt(result[0]*result[0]+result[1]*result[1]+result[2]*result[2]+result[3]*result[3]) ;
+			for(int cpt=0 ; cpt<4 ; ++cpt) { result[cpt] *= inverse ; }
+		}
+
+		/// \brief	Spherical linear interpolation of two quaternions (w, x, y, z) on the shortest path.
+		static void slerp(const float * q0, const float * q1, float t, float * result)
+		{
+			float dot = q0[0]*q1[0]+q0[1]*q1[1]+q0[2]*q1[2]+q0[3]*q1[3] ;
+			float sign = (dot<0.0f) ? -1.0f : 1.0f ;
+			dot = ::std::min(dot*sign, 1.0f) ;
+			if(dot>0.9995f) { nlerp(q0, q1, t, result) ; return ; }
+			float angle = ::std::acos(dot) ;
+			float inverse = 1.0f/::std::sin(angle) ;
+			float t0 = ::std::sin((1.0f-t)*angle)*inverse ;
+			float t1 = ::std::sin(t*angle)*inverse*sign ;
+			for(int cpt=0 ; cpt<4 ; ++cpt) { result[cpt] = q0[cpt]*t0+q1[cpt]*t1 ; }
+		}
+
+		/// \brief	The angle between two rotations (from the relative rotation conjugate(q0) * q1, acos
+		/// 		of the dot product is not precise enough for small angles in single precision).
+		static float angle(const float * q0, const float * q1)
+		{
+			float w = q0[0]*q1[0]+q0[1]*q1[1]+q0[2]*q1[2]+q0[3]*q1[3] ;
+			float x = q0[0]*q1[1]-q0[1]*q1[0]-q0[2]*q1[3]+q0[3]*q1[2] ;
+			float y = q0[0]*q1[2]-q0[2]*q1[0]-q0[3]*q1[1]+q0[1]*q1[3] ;
+			float z = q0[0]*q1[3]-q0[3]*q1[0]-q0[1]*q1[2]+q0[2]*q1[1] ;
+			return 2.0f*::std::atan2(::std::sqrt(x*x+y*y+z*z), ::std::abs(w)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static QuantizedVector AnimationClip::encodeRotation(const float * quaternion)
+		///
+		/// \brief	Smallest three encoding of a unit quaternion (w, x, y, z): the largest component is
+		/// 		made positive and dropped, its index is stored in the high bits of the first two values.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static QuantizedVector encodeRotation(const float * quaternion)
+		{
+			int largest = 0 ;
+			for(int cpt=1 ; cpt<4 ; ++cpt)
+			{
+				if(::std::abs(quaternion[cpt])>::std::abs(quaternion[largest])) { largest = cpt ; }
+			}
+			float sign = (quaternion[largest]<0.0f) ? -1.0f : 1.0f ;
+			QuantizedVector result ;
+			for(int cpt=0, component=0 ; cpt<4 ; ++cpt)
+			{
+				if(cpt==largest) { continue ; }
+				float value = (quaternion[cpt]*sign+0.70710678f)*smallestThreeScale() ;
+				result.m_components[component++] = ::std::uint16_t(::std::min(::std::max(value+0.5f, 0.0f), 32767.0f)) ;
+			}
+			result.m_components[0] |= ::std::uint16_t((largest>>1)<<15) ;
+			result.m_components[1] |= ::std::uint16_t((largest&1)<<15) ;
+			return result ;
+		}
+
+		/// \brief	Decodes a smallest three encoded quaternion (w, x, y, z).
+		static void decodeRotation(const QuantizedVector & rotation, float * result)
+		{
+			const int largest = ((rotation.m_components[0]>>15)<<1)|(rotation.m_components[1]>>15) ;
+			const float scale = 1.0f/smallestThreeScale() ;
+			float values[3] ;
+			float sum = 0.0f ;
+			for(int cpt=0 ; cpt<3 ; ++cpt)
+			{
+				values[cpt] = float(rotation.m_components[cpt]&0x7fff)*scale-0.70710678f ;
+				sum += values[cpt]*values[cpt] ;
+			}
+			for(int cpt=0, component=0 ; cpt<4 ; ++cpt)
+			{
+				result[cpt] = (cpt==largest) ? ::std::sqrt(::std::max(1.0f-sum, 0.0f)) : values[component++] ;
+			}
+		}
+
+		QuantizedVector encodeTranslation(size_t bone, const Math::Vector3f & translation) const
+		{
+			QuantizedVector result ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				float step = m_translationSteps[bone][axis] ;
+				float value = (step>0.0f) ? (translation[axis]-m_translationOrigins[bone][axis])/step : 0.0f ;
+				result.m_components[axis] = ::std::uint16_t(::std::min(::std::max(value+0.5f, 0.0f), 65535.0f)) ;
+			}
+			return result ;
+		}
+
+		void decodeTranslation(size_t bone, const QuantizedVector & translation, float * result) const
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				result[axis] = m_translationOrigins[bone][axis]+float(translation.m_components[axis])*m_translationSteps[bone][axis] ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Fits> static void AnimationClip::reduce(size_t first, size_t last,
+		/// 	const Fits & fits, ::std::vector<size_t> & keys)
+		///
+		/// \brief	Greedy key reduction on the frames [first, last]: starting from a key, the next key is
+		/// 		the farthest frame such that all the frames in between are interpolated within the
+		/// 		tolerance. If the key of the first frame fits the whole range, it is the only key.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Fits	bool(size_t key0, size_t key1, size_t frame): is frame interpolated between the
+		/// 				keys key0 and key1 within the tolerance (key0==key1 for a constant).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Fits>
+		static void reduce(size_t first, size_t last, const Fits & fits, ::std::vector<size_t> & keys)
+		{
+			keys.clear() ;
+			keys.push_back(first) ;
+			bool constant = true ;
+			for(size_t frame=first+1 ; frame<=last && constant ; ++frame) { constant = fits(first, first, frame) ; }
+			if(constant) { return ; }
+			size_t key = first ;
+			while(key<last)
+			{
+				size_t next = key+1 ;
+				for(size_t candidate=key+2 ; candidate<=last ; ++candidate)
+				{
+					bool valid = true ;
+					for(size_t frame=key+1 ; frame<candidate && valid ; ++frame) { valid = fits(key, candidate, frame) ; }
+					if(!valid) { break ; }
+					next = candidate ;
+				}
+				keys.push_back(next) ;
+				key = next ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void AnimationClip::build(const BonePose * frames, float angularTolerance,
+		/// 	float translationTolerance)
+		///
+		/// \brief	Quantizes and reduces the frames (m_bones, m_frames, m_rate and m_segmentFrames are set).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build(const BonePose * frames, float angularTolerance, float translationTolerance)
+		{
+			assert(m_frames>0 && m_segmentFrames>0 && m_segmentFrames<256) ;
+			m_segments = ::std::max<size_t>((m_frames-1+m_segmentFrames-1)/m_segmentFrames, 1) ;
+			// Translation ranges
+			m_translationOrigins.assign(m_bones, Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+			m_translationSteps.assign(m_bones, Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+			for(size_t bone=0 ; bone<m_bones ; ++bone)
+			{
+				Math::Vector3f minimum = frames[bone].m_translation ;
+				Math::Vector3f maximum = minimum ;
+				for(size_t frame=1 ; frame<m_frames ; ++frame)
+				{
+					const Math::Vector3f & translation = frames[frame*m_bones+bone].m_translation ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						minimum[axis] = ::std::min(minimum[axis], translation[axis]) ;
+						maximum[axis] = ::std::max(maximum[axis], translation[axis]) ;
+					}
+				}
+				m_translationOrigins[bone] = minimum ;
+				for(int axis=0 ; axis<3 ; ++axis) { m_translationSteps[bone][axis] = (maximum[axis]-minimum[axis])/65535.0f ; }
+			}
+			// Original and quantized values
+			const size_t values = m_frames*m_bones ;
+			::std::vector<float> rotations(4*values), decodedRotations(4*values) ;
+			::std::vector<float> translations(3*values), decodedTranslations(3*values) ;
+			::std::vector<QuantizedVector> quantizedRotations(values), quantizedTranslations(values) ;
+			for(size_t frame=0 ; frame<m_frames ; ++frame)
+			{
+				for(size_t bone=0 ; bone<m_bones ; ++bone)
+				{
+					const size_t index = frame*m_bones+bone ;
+					toArray(frames[index].m_rotation, &rotations[4*index]) ;
+					quantizedRotations[index] = encodeRotation(&rotations[4*index]) ;
+					decodeRotation(quantizedRotations[index], &decodedRotations[4*index]) ;
+					for(int axis=0 ; axis<3 ; ++axis) { translations[3*index+axis] = frames[index].m_translation[axis] ; }
+					quantizedTranslations[index] = encodeTranslation(bone, frames[index].m_translation) ;
+					decodeTranslation(bone, quantizedTranslations[index], &decodedTranslations[3*index]) ;
+				}
+			}
+			// Key reduction segment by segment, the errors include the quantization
+			m_rotationStart.clear() ;
+			m_rotationFrames.clear() ;
+			m_rotations.clear() ;
+			m_translationStart.clear() ;
+			m_translationFrames.clear() ;
+			m_translations.clear() ;
+			::std::vector<size_t> keys ;
+			const size_t bones = m_bones ;
+			for(size_t segment=0 ; segment<m_segments ; ++segment)
+			{
+				const size_t first = segment*m_segmentFrames ;
+				const size_t last = ::std::min(first+m_segmentFrames, m_frames-1) ;
+				for(size_t bone=0 ; bone<m_bones ; ++bone)
+				{
+					reduce(first, last, [&rotations, &decodedRotations, bones, bone, angularTolerance](size_t key0, size_t key1, size_t frame)
+					{
+						float interpolated[4] ;
+						float t = (key0==key1) ? 0.0f : float(frame-key0)/float(key1-key0) ;
+						nlerp(&decodedRotations[4*(key0*bones+bone)], &decodedRotations[4*(key1*bones+bone)], t, interpolated) ;
+						return angle(interpolated, &rotations[4*(frame*bones+bone)])<=angularTolerance ;
+					}, keys) ;
+					m_rotationStart.push_back(::std::uint32_t(m_rotations.size())) ;
+					for(auto it=keys.begin(), end=keys.end() ; it!=end ; ++it)
+					{
+						m_rotationFrames.push_back(::std::uint8_t(*it-first)) ;
+						m_rotations.push_back(quantizedRotations[*it*m_bones+bone]) ;
+					}
+					reduce(first, last, [&translations, &decodedTranslations, bones, bone, translationTolerance](size_t key0, size_t key1, size_t frame)
+					{
+						float t = (key0==key1) ? 0.0f : float(frame-key0)/float(key1-key0) ;
+						const float * t0 = &decodedTranslations[3*(key0*bones+bone)] ;
+						const float * t1 = &decodedTranslations[3*(key1*bones+bone)] ;
+						const float * original = &translations[3*(frame*bones+bone)] ;
+						float error = 0.0f ;
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							float delta = t0[axis]+(t1[axis]-t0[axis])*t-original[axis] ;
+							error += delta*delta ;
+						}
+						return error<=translationTolerance*translationTolerance ;
+					}, keys) ;
+					m_translationStart.push_back(::std::uint32_t(m_translations.size())) ;
+					for(auto it=keys.begin(), end=keys.end() ; it!=end ; ++it)
+					{
+						m_translationFrames.push_back(::std::uint8_t(*it-first)) ;
+						m_translations.push_back(quantizedTranslations[*it*m_bones+bone]) ;
+					}
+				}
+			}
+			m_rotationStart.push_back(::std::uint32_t(m_rotations.size())) ;
+			m_translationStart.push_back(::std::uint32_t(m_translations.size())) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	AnimationClip::AnimationClip(const BonePose * frames, size_t frameCount, size_t bones,
+		/// 	float rate, float angularTolerance = 0.001f, float translationTolerance = 0.001f,
+		/// 	unsigned int segmentFrames = 32)
+		///
+		/// \brief	Builds a clip from sampled poses.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	frames				  	The poses (frameCount x bones values, frame major).
+		/// \param	frameCount			  	The number of frames.
+		/// \param	bones				  	The number of bones.
+		/// \param	rate				  	The number of frames per second.
+		/// \param	angularTolerance	  	(optional) The maximum rotation error (radians).
+		/// \param	translationTolerance  	(optional) The maximum translation error.
+		/// \param	segmentFrames		  	(optional) The number of frames per segment (less than 256).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		AnimationClip(const BonePose * frames, size_t frameCount, size_t bones, float rate, float angularTolerance = 0.001f, float translationTolerance = 0.001f, unsigned int segmentFrames = 32)
+			: m_bones(bones), m_frames(frameCount), m_rate(rate), m_segmentFrames(segmentFrames), m_segments(0)
+		{
+			build(frames, angularTolerance, translationTolerance) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	AnimationClip::AnimationClip(const HelperGl::LoaderOgre3D::Skeleton & skeleton,
+		/// 	const HelperGl::LoaderOgre3D::Skeleton::Animation & animation, float rate = 30.0f,
+		/// 	float angularTolerance = 0.001f, float translationTolerance = 0.001f,
+		/// 	unsigned int segmentFrames = 32)
+		///
+		/// \brief	Builds a clip from an animation of a skeleton loaded by LoaderOgre3D (see resample).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		AnimationClip(const HelperGl::LoaderOgre3D::Skeleton & skeleton, const HelperGl::LoaderOgre3D::Skeleton::Animation & animation, float rate = 30.0f,
+					  float angularTolerance = 0.001f, float translationTolerance = 0.001f, unsigned int segmentFrames = 32)
+			: m_bones(skeleton.size()), m_frames(0), m_rate(rate), m_segmentFrames(segmentFrames), m_segments(0)
+		{
+			::std::vector<BonePose> frames ;
+			m_frames = resample(skeleton, animation, rate, frames) ;
+			build(frames.data(), angularTolerance, translationTolerance) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static size_t AnimationClip::resample(const HelperGl::LoaderOgre3D::Skeleton & skeleton,
+		/// 	const HelperGl::LoaderOgre3D::Skeleton::Animation & animation, float rate,
+		/// 	::std::vector<BonePose> & frames)
+		///
+		/// \brief	Samples an animation at a fixed rate (linear interpolation of the translations,
+		/// 		spherical interpolation of the rotations between keyframes, as Ogre).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	skeleton 	The skeleton.
+		/// \param 		 	animation	The animation.
+		/// \param 		 	rate	 	The number of frames per second.
+		/// \param [in,out]	frames   	The poses (frame major, skeleton.size() per frame).
+		///
+		/// \return	The number of frames.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static size_t resample(const HelperGl::LoaderOgre3D::Skeleton & skeleton, const HelperGl::LoaderOgre3D::Skeleton::Animation & animation, float rate, ::std::vector<BonePose> & frames)
+		{
+			typedef HelperGl::LoaderOgre3D::Skeleton::Keyframe Keyframe ;
+			const size_t bones = skeleton.size() ;
+			const size_t frameCount = size_t(::std::ceil(::std::max(animation.m_length, 0.0f)*rate-0.001f))+1 ;
+			frames.assign(frameCount*bones, BonePose()) ;
+			for(auto track=animation.m_tracks.begin(), end=animation.m_tracks.end() ; track!=end ; ++track)
+			{
+				const int bone = skeleton.indexOfName(track->m_bone) ;
+				const ::std::vector<Keyframe> & keyframes = track->m_keyframes ;
+				if(bone<0 || keyframes.empty()) { continue ; }
+				::std::vector<float> rotations(4*keyframes.size()) ;
+				for(size_t cpt=0 ; cpt<keyframes.size() ; ++cpt)
+				{
+					const Keyframe & keyframe = keyframes[cpt] ;
+					Math::Quaternion<float> rotation(1.0f, Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+					if(keyframe.m_rotationAxis.norm()>0.0f) { rotation = Math::Quaternion<float>(keyframe.m_rotationAxis.normalized(), keyframe.m_rotationAngle) ; }
+					toArray(rotation, &rotations[4*cpt]) ;
+				}
+				size_t next = 0 ;
+				for(size_t frame=0 ; frame<frameCount ; ++frame)
+				{
+					const float time = ::std::min(float(frame)/rate, animation.m_length) ;
+					while(next<keyframes.size() && keyframes[next].m_time<=time) { ++next ; }
+					size_t key0 = (next==0) ? 0 : next-1 ;
+					size_t key1 = ::std::min(next, keyframes.size()-1) ;
+					float duration = keyframes[key1].m_time-keyframes[key0].m_time ;
+					float t = (duration>0.0f) ? (time-keyframes[key0].m_time)/duration : 0.0f ;
+					float rotation[4] ;
+					slerp(&rotations[4*key0], &rotations[4*key1], t, rotation) ;
+					BonePose & pose = frames[frame*bones+bone] ;
+					pose.m_rotation = Math::Quaternion<float>(rotation[0], Math::makeVector(rotation[1], rotation[2], rotation[3])) ;
+					pose.m_translation = keyframes[key0].m_translation+(keyframes[key1].m_translation-keyframes[key0].m_translation)*t ;
+				}
+			}
+			return frameCount ;
+		}
+
+		size_t bones() const
+		{
+			return m_bones ;
+		}
+
+		size_t frames() const
+		{
+			return m_frames ;
+		}
+
+		/// \brief	The duration (seconds).
+		float duration() const
+		{
+			return float(m_frames-1)/m_rate ;
+		}
+
+		/// \brief	The number of rotation and translation keys.
+		size_t keys() const
+		{
+			return m_rotations.size()+m_translations.size() ;
+		}
+
+		/// \brief	The memory used by the clip (bytes).
+		size_t bytes() const
+		{
+			return sizeof(*this)+(m_rotationStart.size()+m_translationStart.size())*sizeof(::std::uint32_t)
+				+ m_rotationFrames.size()+m_translationFrames.size()
+				+ (m_rotations.size()+m_translations.size())*sizeof(QuantizedVector)
+				+ (m_translationOrigins.size()+m_translationSteps.size())*sizeof(Math::Vector3f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void AnimationClip::sample(float time, BonePose * pose) const
+		///
+		/// \brief	Samples the clip (the time is clamped to [0, duration()], use fmod to loop).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	time	The time (seconds).
+		/// \param [in,out]	pose	The pose of each bone (bones() values).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void sample(float time, BonePose * pose) const
+		{
+			const float frame = ::std::min(::std::max(time*m_rate, 0.0f), float(m_frames-1)) ;
+			const size_t segment = ::std::min(size_t(frame)/m_segmentFrames, m_segments-1) ;
+			const float local = frame-float(segment*m_segmentFrames) ;
+			const ::std::uint32_t * rotationStart = m_rotationStart.data()+segment*m_bones ;
+			const ::std::uint32_t * translationStart = m_translationStart.data()+segment*m_bones ;
+			for(size_t bone=0 ; bone<m_bones ; ++bone)
+			{
+				float rotation[4] ;
+				size_t key = rotationStart[bone] ;
+				const size_t rotationEnd = rotationStart[bone+1] ;
+				if(rotationEnd-key==1) { decodeRotation(m_rotations[key], rotation) ; }
+				else
+				{
+					while(key+2<rotationEnd && float(m_rotationFrames[key+1])<=local) { ++key ; }
+					float q0[4], q1[4] ;
+					decodeRotation(m_rotations[key], q0) ;
+					decodeRotation(m_rotations[key+1], q1) ;
+					float frame0 = float(m_rotationFrames[key]) ;
+					float t = ::std::min((local-frame0)/(float(m_rotationFrames[key+1])-frame0), 1.0f) ;
+					nlerp(q0, q1, t, rotation) ;
+				}
+				float translation[3] ;
+				key = translationStart[bone] ;
+				const size_t translationEnd = translationStart[bone+1] ;
+				if(translationEnd-key==1) { decodeTranslation(bone, m_translations[key], translation) ; }
+				else
+				{
+					while(key+2<translationEnd && float(m_translationFrames[key+1])<=local) { ++key ; }
+					float t0[3], t1[3] ;
+					decodeTranslation(bone, m_translations[key], t0) ;
+					decodeTranslation(bone, m_translations[key+1], t1) ;
+					float frame0 = float(m_translationFrames[key]) ;
+					float t = ::std::min((local-frame0)/(float(m_translationFrames[key+1])-frame0), 1.0f) ;
+					for(int axis=0 ; axis<3 ; ++axis) { translation[axis] = t0[axis]+(t1[axis]-t0[axis])*t ; }
+				}
+				pose[bone].m_rotation = Math::Quaternion<float>(rotation[0], Math::makeVector(rotation[1], rotation[2], rotation[3])) ;
+				pose[bone].m_translation = Math::makeVector(translation[0], translation[1], translation[2]) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void AnimationClip::blend(const BonePose * first, const BonePose * second,
+		/// 	size_t bones, float weight, BonePose * result, const float * boneWeights = NULL)
+		///
+		/// \brief	Blends two poses (normalized linear interpolation of the rotations, linear
+		/// 		interpolation of the translations). result may be first or second.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	first	   	The first pose.
+		/// \param 		 	second	   	The second pose.
+		/// \param 		 	bones	   	The number of bones.
+		/// \param 		 	weight	   	The weight of the second pose.
+		/// \param [in,out]	result	   	The blended pose.
+		/// \param 		 	boneWeights	(optional) Per bone factors of weight (masks), null for 1.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void blend(const BonePose * first, const BonePose * second, size_t bones, float weight, BonePose * result, const float * boneWeights = NULL)
+		{
+			for(size_t bone=0 ; bone<bones ; ++bone)
+			{
+				const float t = (boneWeights==NULL) ? weight : weight*boneWeights[bone] ;
+				float q0[4], q1[4], rotation[4] ;
+				toArray(first[bone].m_rotation, q0) ;
+				toArray(second[bone].m_rotation, q1) ;
+				nlerp(q0, q1, t, rotation) ;
+				result[bone].m_translation = first[bone].m_translation+(second[bone].m_translation-first[bone].m_translation)*t ;
+				result[bone].m_rotation = Math::Quaternion<float>(rotation[0], Math::makeVector(rotation[1], rotation[2], rotation[3])) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void AnimationClip::sampleBlend(const AnimationClip & first, float firstTime,
+		/// 	const AnimationClip & second, float secondTime, float weight, BonePose * buffer,
+		/// 	BonePose * result)
+		///
+		/// \brief	Samples two clips of the same skeleton and blends them.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	first	  	The first clip.
+		/// \param 		 	firstTime 	The time in the first clip.
+		/// \param 		 	second	  	The second clip.
+		/// \param 		 	secondTime	The time in the second clip.
+		/// \param 		 	weight	  	The weight of the second clip.
+		/// \param [in,out]	buffer	  	A buffer of bones() poses.
+		/// \param [in,out]	result	  	The blended pose.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void sampleBlend(const AnimationClip & first, float firstTime, const AnimationClip & second, float secondTime, float weight, BonePose * buffer, BonePose * result)
+		{
+			assert(first.bones()==second.bones()) ;
+			first.sample(firstTime, result) ;
+			second.sample(secondTime, buffer) ;
+			blend(result, buffer, first.bones(), weight, result) ;
+		}
+	};
+}
+
+#endif
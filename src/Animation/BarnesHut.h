@@ -0,0 +1,592 @@
+#ifndef _Animation_BarnesHut_H
+#define _Animation_BarnesHut_H
+
+#include <Animation/ParticleSystem.h>
+#include <Animation/PonctualMass.h>
+#include <Utils/RadixSort.h>
+#include <Math/Vectorf.h>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/combinable.h>
+
+namespace Animation
+{
+	namespace Physics
+	{
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	BarnesHut
+		///
+		/// \brief	Mutual (gravitational like) attraction between particles computed with the Barnes-Hut
+		/// 		approximation in O(n log n). At each build, the particles are sorted on the Morton
+		/// 		code of their position (parallel radix sort) and a linear octree is built on the
+		/// 		sorted array: the particles of a node are a contiguous range and nodes are stored in
+		/// 		depth first order with the index of the next sibling, the traversal needs no stack.
+		/// 		Each node stores its center of mass and total mass. When a node is seen from a
+		/// 		position under an angle (size / distance) lower than the opening angle, its particles
+		/// 		are replaced by its center of mass. The upper levels of the octree are built in
+		/// 		parallel and forces are evaluated in parallel over the leaves.
+		/// 		The force between masses m1 and m2 is G*m1*m2*r/(|r|^2+softening^2)^(3/2).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class BarnesHut
+		{
+		protected:
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \class	Node
+			///
+			/// \brief	A node of the octree.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			class Node
+			{
+			public:
+				/// \brief	The center of mass.
+				Math::Vector3f m_center ;
+				/// \brief	The total mass.
+				float m_mass ;
+				/// \brief	The squared size of the cell.
+				float m_size2 ;
+				/// \brief	The first particle (in the sorted arrays).
+				::std::uint32_t m_begin ;
+				/// \brief	The end of the range of particles.
+				::std::uint32_t m_end ;
+				/// \brief	The index of the node following the sub tree of this node.
+				::std::uint32_t m_next ;
+				/// \brief	The lower corner of the bounding box of the particles.
+				Math::Vector3f m_boxMin ;
+				/// \brief	The upper corner of the bounding box of the particles.
+				Math::Vector3f m_boxMax ;
+				/// \brief	true if the node is a leaf.
+				bool m_isLeaf ;
+			};
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \class	InteractionList
+			///
+			/// \brief	The interactions of the particles of a leaf: approximated nodes (center of mass and
+			/// 		mass stored in separate arrays) and ranges of particles summed directly.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			class InteractionList
+			{
+			public:
+				::std::vector<float> m_x, m_y, m_z, m_mass ;
+				::std::vector<::std::pair<::std::uint32_t, ::std::uint32_t>> m_ranges ;
+
+				void clear()
+				{
+					m_x.clear() ; m_y.clear() ; m_z.clear() ; m_mass.clear() ; m_ranges.clear() ;
+				}
+			};
+
+			/// \brief	Number of bits per axis of the Morton codes.
+			enum { levels = 10 } ;
+
+			/// \brief	The gravitational constant.
+			float m_gravitationalConstant ;
+			/// \brief	The squared opening angle.
+			float m_theta2 ;
+			/// \brief	The squared softening distance.
+			float m_softening2 ;
+			/// \brief	The maximum number of particles in a leaf.
+			size_t m_leafSize ;
+			/// \brief	The grain size used for parallel loops.
+			size_t m_grainSize ;
+
+			/// \brief	The Morton codes of the particles.
+			::std::vector<::std::uint32_t> m_codes ;
+			/// \brief	The sorter.
+			Utils::RadixSort m_sorter ;
+			/// \brief	The sorted Morton codes.
+			::std::vector<::std::uint32_t> m_sortedCodes ;
+			/// \brief	The positions of the sorted particles.
+			::std::vector<Math::Vector3f> m_positions ;
+			/// \brief	The masses of the sorted particles.
+			::std::vector<float> m_masses ;
+			/// \brief	The nodes of the octree (depth first order).
+			::std::vector<Node> m_nodes ;
+			/// \brief	The indexes of the leaves.
+			::std::vector<::std::uint32_t> m_leaves ;
+			/// \brief	The permutation of the last sort (sorted index -> particle index).
+			::std::vector<::std::uint32_t> m_permutation ;
+			/// \brief	The accelerations of the particles (particle order), see computeAccelerations.
+			::std::vector<Math::Vector3f> m_accelerations ;
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	static ::std::uint32_t BarnesHut::expandBits(::std::uint32_t value)
+			///
+			/// \brief	Inserts two 0 bits after each of the 10 lower bits of value.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			static ::std::uint32_t expandBits(::std::uint32_t value)
+			{
+				value = (value * 0x00010001u) & 0xFF0000FFu ;
+				value = (value * 0x00000101u) & 0x0F00F00Fu ;
+				value = (value * 0x00000011u) & 0xC30C30C3u ;
+				value = (value * 0x00000005u) & 0x49249249u ;
+				return value ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void BarnesHut::buildNode(::std::vector<Node> & nodes, ::std::vector<::std::uint32_t> & leaves,
+			/// 	::std::uint32_t begin, ::std::uint32_t end, int level, float size2)
+			///
+			/// \brief	Recursively builds the node containing the sorted particles [begin;end) and its
+			/// 		sub tree, appended to nodes. The sub trees of the children of a node containing more
+			/// 		than 8*grainSize particles are built in parallel in separate arrays, then appended
+			/// 		in depth first order (their node indexes are offset).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param [in,out]	nodes 	The nodes, the sub tree is appended.
+			/// \param [in,out]	leaves	The indexes of the leaves (in nodes), the leaves of the sub tree are appended.
+			/// \param	begin			  	The first particle.
+			/// \param	end  			  	The end of the range of particles.
+			/// \param	level			  	The level of the node (0 is the root).
+			/// \param	size2			  	The squared size of the cell of the node.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void buildNode(::std::vector<Node> & nodes, ::std::vector<::std::uint32_t> & leaves, ::std::uint32_t begin, ::std::uint32_t end, int level, float size2)
+			{
+				size_t index = nodes.size() ;
+				nodes.push_back(Node()) ;
+				Math::Vector3f center = Math::makeVector(0.0f, 0.0f, 0.0f) ;
+				float mass = 0.0f ;
+				const float max = ::std::numeric_limits<float>::max() ;
+				Math::Vector3f boxMin = Math::makeVector(max, max, max) ;
+				Math::Vector3f boxMax = Math::makeVector(-max, -max, -max) ;
+				bool isLeaf = (end-begin<=m_leafSize) || level==levels ;
+				if(isLeaf)
+				{
+					for(::std::uint32_t cpt=begin ; cpt<end ; ++cpt)
+					{
+						center += m_positions[cpt]*m_masses[cpt] ;
+						mass += m_masses[cpt] ;
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							boxMin[axis] = ::std::min(boxMin[axis], m_positions[cpt][axis]) ;
+							boxMax[axis] = ::std::max(boxMax[axis], m_positions[cpt][axis]) ;
+						}
+					}
+					leaves.push_back((::std::uint32_t)index) ;
+				}
+				else
+				{
+					// The children are the ranges sharing the same 3 bits of the Morton code at this level
+					const int shift = 3*(levels-1-level) ;
+					const ::std::uint32_t * codes = m_sortedCodes.data() ;
+					::std::uint32_t bounds[9] = { begin } ;
+					size_t childCount = 0 ;
+					while(bounds[childCount]<end)
+					{
+						::std::uint32_t digit = (codes[bounds[childCount]]>>shift)&7 ;
+						bounds[childCount+1] = (::std::uint32_t)(::std::partition_point(codes+bounds[childCount], codes+end,
+							[shift, digit](::std::uint32_t code) { return ((code>>shift)&7)==digit ; })-codes) ;
+						++childCount ;
+					}
+					size_t children[8] ;
+					if(end-begin>8*m_grainSize)
+					{
+						::std::vector<Node> childNodes[8] ;
+						::std::vector<::std::uint32_t> childLeaves[8] ;
+						::tbb::parallel_for((size_t)0, childCount, [this, &childNodes, &childLeaves, &bounds, level, size2](size_t child)
+						{
+							childNodes[child].reserve(2*(bounds[child+1]-bounds[child])/m_leafSize+levels*8) ;
+							buildNode(childNodes[child], childLeaves[child], bounds[child], bounds[child+1], level+1, size2*0.25f) ;
+						}) ;
+						for(size_t child=0 ; child<childCount ; ++child)
+						{
+							const ::std::uint32_t offset = (::std::uint32_t)nodes.size() ;
+							children[child] = offset ;
+							nodes.insert(nodes.end(), childNodes[child].begin(), childNodes[child].end()) ;
+							for(size_t cpt=offset ; cpt<nodes.size() ; ++cpt) { nodes[cpt].m_next += offset ; }
+							for(auto it=childLeaves[child].begin() ; it!=childLeaves[child].end() ; ++it) { leaves.push_back(*it+offset) ; }
+						}
+					}
+					else
+					{
+						for(size_t child=0 ; child<childCount ; ++child)
+						{
+							children[child] = nodes.size() ;
+							buildNode(nodes, leaves, bounds[child], bounds[child+1], level+1, size2*0.25f) ;
+						}
+					}
+					for(size_t child=0 ; child<childCount ; ++child)
+					{
+						const Node & childNode = nodes[children[child]] ;
+						center += childNode.m_center*childNode.m_mass ;
+						mass += childNode.m_mass ;
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							boxMin[axis] = ::std::min(boxMin[axis], childNode.m_boxMin[axis]) ;
+							boxMax[axis] = ::std::max(boxMax[axis], childNode.m_boxMax[axis]) ;
+						}
+					}
+				}
+				Node & node = nodes[index] ;
+				node.m_center = (mass>0.0f) ? center/mass : center ;
+				node.m_mass = mass ;
+				node.m_size2 = size2 ;
+				node.m_begin = begin ;
+				node.m_end = end ;
+				node.m_boxMin = boxMin ;
+				node.m_boxMax = boxMax ;
+				node.m_isLeaf = isLeaf ;
+				node.m_next = (::std::uint32_t)nodes.size() ;
+			}
+
+		public:
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	BarnesHut::BarnesHut(float gravitationalConstant, float theta = 0.5f, float softening = 0.01f,
+			/// 	size_t leafSize = 16, size_t grainSize = 2000)
+			///
+			/// \brief	Constructor.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	gravitationalConstant	The gravitational constant.
+			/// \param	theta				 	(optional) the opening angle (0 gives the exact O(n^2) sum,
+			/// 								usual values are in [0.3;1]).
+			/// \param	softening			 	(optional) the softening distance (avoids infinite forces, must be
+			/// 								strictly positive).
+			/// \param	leafSize			 	(optional) the maximum number of particles in a leaf.
+			/// \param	grainSize			 	(optional) the grain size used for parallel loops.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			BarnesHut(float gravitationalConstant, float theta = 0.5f, float softening = 0.01f, size_t leafSize = 16, size_t grainSize = 2000)
+				: m_gravitationalConstant(gravitationalConstant), m_theta2(theta*theta), m_softening2(softening*softening),
+				  m_leafSize(::std::max<size_t>(leafSize, 1)), m_grainSize(::std::max<size_t>(grainSize, 1))
+			{
+				assert(softening>0.0f) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void BarnesHut::setTheta(float theta)
+			///
+			/// \brief	Sets the opening angle.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void setTheta(float theta)
+			{
+				m_theta2 = theta*theta ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	template <class ParticleType> void BarnesHut::build(const ParticleSystem::Range<ParticleType> & particles)
+			///
+			/// \brief	Builds the octree from the particles.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	particles	The particles.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			template <class ParticleType>
+			void build(const ParticleSystem::Range<ParticleType> & particles)
+			{
+				const size_t size = particles.size() ;
+				m_nodes.clear() ;
+				m_leaves.clear() ;
+				if(size==0) { return ; }
+				m_nodes.reserve(2*size/m_leafSize+levels*8) ;
+				// Bounding cube of the particles
+				typedef ::std::pair<Math::Vector3f, Math::Vector3f> Box ;
+				::tbb::combinable<Box> boxes([]()
+				{
+					float max = ::std::numeric_limits<float>::max() ;
+					return Box(Math::makeVector(max, max, max), Math::makeVector(-max, -max, -max)) ;
+				}) ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, m_grainSize), [&particles, &boxes](const ::tbb::blocked_range<size_t> & range)
+				{
+					Box & box = boxes.local() ;
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+					{
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							box.first[axis] = ::std::min(box.first[axis], particles[cpt].m_position[axis]) ;
+							box.second[axis] = ::std::max(box.second[axis], particles[cpt].m_position[axis]) ;
+						}
+					}
+				}) ;
+				Box box = boxes.combine([](const Box & a, const Box & b)
+				{
+					Box result ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						result.first[axis] = ::std::min(a.first[axis], b.first[axis]) ;
+						result.second[axis] = ::std::max(a.second[axis], b.second[axis]) ;
+					}
+					return result ;
+				}) ;
+				float extent = ::std::max(::std::max(box.second[0]-box.first[0], box.second[1]-box.first[1]), box.second[2]-box.first[2]) ;
+				extent = ::std::max(extent, 1e-6f) ;
+				// Morton codes
+				const Math::Vector3f origin = box.first ;
+				const float scale = float(1<<levels)/extent ;
+				const float maxCoordinate = float((1<<levels)-1) ;
+				m_codes.resize(size) ;
+				::std::uint32_t * codes = m_codes.data() ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, m_grainSize), [&particles, codes, origin, scale, maxCoordinate](const ::tbb::blocked_range<size_t> & range)
+				{
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+					{
+						const Math::Vector3f & position = particles[cpt].m_position ;
+						::std::uint32_t code = 0 ;
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							::std::uint32_t coordinate = (::std::uint32_t)::std::min((position[axis]-origin[axis])*scale, maxCoordinate) ;
+							code |= expandBits(coordinate) << (2-axis) ;
+						}
+						codes[cpt] = code ;
+					}
+				}) ;
+				// Sort and gather of the positions and masses
+				m_sorter.sort(codes, size, (1u<<(3*levels))-1) ;
+				m_sortedCodes.resize(size) ;
+				m_positions.resize(size) ;
+				m_masses.resize(size) ;
+				m_permutation.assign(m_sorter.permutation(), m_sorter.permutation()+size) ;
+				const ::std::uint32_t * permutation = m_permutation.data() ;
+				::std::copy(m_sorter.keys(), m_sorter.keys()+size, m_sortedCodes.begin()) ;
+				Math::Vector3f * positions = m_positions.data() ;
+				float * masses = m_masses.data() ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, m_grainSize), [&particles, permutation, positions, masses](const ::tbb::blocked_range<size_t> & range)
+				{
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+					{
+						positions[cpt] = particles[permutation[cpt]].m_position ;
+						masses[cpt] = particles[permutation[cpt]].m_mass ;
+					}
+				}) ;
+				// Octree
+				buildNode(m_nodes, m_leaves, 0, (::std::uint32_t)size, 0, extent*extent) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f BarnesHut::acceleration(const Math::Vector3f & position) const
+			///
+			/// \brief	Computes the attraction exerted by the particles on a unit mass (i.e. the
+			/// 		acceleration) at a given position.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	position	The position.
+			///
+			/// \return	The acceleration.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f acceleration(const Math::Vector3f & position) const
+			{
+				const Node * nodes = m_nodes.data() ;
+				const Math::Vector3f * positions = m_positions.data() ;
+				const float * masses = m_masses.data() ;
+				const ::std::uint32_t nodeCount = (::std::uint32_t)m_nodes.size() ;
+				float result[3] = { 0.0f, 0.0f, 0.0f } ;
+				::std::uint32_t current = 0 ;
+				while(current<nodeCount)
+				{
+					const Node & node = nodes[current] ;
+					float delta[3] = { node.m_center[0]-position[0], node.m_center[1]-position[1], node.m_center[2]-position[2] } ;
+					float distance2 = delta[0]*delta[0]+delta[1]*delta[1]+delta[2]*delta[2] ;
+					if(node.m_size2<m_theta2*distance2) // Far enough: approximated by the center of mass
+					{
+						float inverse = 1.0f/::std::sqrt(distance2+m_softening2) ;
+						float factor = node.m_mass*inverse*inverse*inverse ;
+						result[0] += delta[0]*factor ; result[1] += delta[1]*factor ; result[2] += delta[2]*factor ;
+						current = node.m_next ;
+					}
+					else if(node.m_isLeaf) // Direct summation
+					{
+						for(::std::uint32_t cpt=node.m_begin ; cpt<node.m_end ; ++cpt)
+						{
+							float dx = positions[cpt][0]-position[0] ;
+							float dy = positions[cpt][1]-position[1] ;
+							float dz = positions[cpt][2]-position[2] ;
+							float inverse = 1.0f/::std::sqrt(dx*dx+dy*dy+dz*dz+m_softening2) ;
+							float factor = masses[cpt]*inverse*inverse*inverse ;
+							result[0] += dx*factor ; result[1] += dy*factor ; result[2] += dz*factor ;
+						}
+						current = node.m_next ;
+					}
+					else { ++current ; } // Opening of the node, the first child follows its parent
+				}
+				return Math::makeVector(result[0], result[1], result[2])*m_gravitationalConstant ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void BarnesHut::computeAccelerations()
+			///
+			/// \brief	Computes the accelerations of all the particles of the last build. The tree is 
+			/// 		traversed once per leaf (in parallel): a node is approximated if it is seen under an
+			/// 		angle lower than the opening angle from all the points of the bounding box of the 
+			/// 		leaf. The resulting interaction list is shared by all the particles of the leaf, it 
+			/// 		is evaluated with loops on contiguous arrays.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void computeAccelerations()
+			{
+				m_accelerations.resize(m_positions.size()) ;
+				const Node * nodes = m_nodes.data() ;
+				const ::std::uint32_t * leaves = m_leaves.data() ;
+				const ::std::uint32_t nodeCount = (::std::uint32_t)m_nodes.size() ;
+				const Math::Vector3f * positions = m_positions.data() ;
+				const float * masses = m_masses.data() ;
+				const ::std::uint32_t * permutation = m_permutation.data() ;
+				Math::Vector3f * accelerations = m_accelerations.data() ;
+				const float theta2 = m_theta2 ;
+				const float softening2 = m_softening2 ;
+				const float gravitationalConstant = m_gravitationalConstant ;
+				::tbb::combinable<InteractionList> lists ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_leaves.size(), ::std::max<size_t>(m_grainSize/m_leafSize, 1)), 
+					[&lists, nodes, leaves, nodeCount, positions, masses, permutation, accelerations, theta2, softening2, gravitationalConstant](const ::tbb::blocked_range<size_t> & range)
+				{
+					InteractionList & list = lists.local() ;
+					for(size_t leafIndex=range.begin() ; leafIndex!=range.end() ; ++leafIndex)
+					{
+						const Node & leaf = nodes[leaves[leafIndex]] ;
+						// Traversal
+						list.clear() ;
+						::std::uint32_t current = 0 ;
+						while(current<nodeCount)
+						{
+							const Node & node = nodes[current] ;
+							float distance2 = 0.0f ; // Squared distance from the center of mass to the box of the leaf
+							for(int axis=0 ; axis<3 ; ++axis)
+							{
+								float delta = ::std::max(::std::max(leaf.m_boxMin[axis]-node.m_center[axis], node.m_center[axis]-leaf.m_boxMax[axis]), 0.0f) ;
+								distance2 += delta*delta ;
+							}
+							if(node.m_size2<theta2*distance2)
+							{
+								list.m_x.push_back(node.m_center[0]) ; list.m_y.push_back(node.m_center[1]) ; list.m_z.push_back(node.m_center[2]) ;
+								list.m_mass.push_back(node.m_mass) ;
+								current = node.m_next ;
+							}
+							else if(node.m_isLeaf)
+							{
+								list.m_ranges.push_back(::std::make_pair(node.m_begin, node.m_end)) ;
+								current = node.m_next ;
+							}
+							else { ++current ; }
+						}
+						// Evaluation for each particle of the leaf
+						const float * x = list.m_x.data() ;
+						const float * y = list.m_y.data() ;
+						const float * z = list.m_z.data() ;
+						const float * mass = list.m_mass.data() ;
+						const size_t approximations = list.m_x.size() ;
+						for(::std::uint32_t particle=leaf.m_begin ; particle<leaf.m_end ; ++particle)
+						{
+							const float px = positions[particle][0], py = positions[particle][1], pz = positions[particle][2] ;
+							float ax = 0.0f, ay = 0.0f, az = 0.0f ;
+							for(size_t cpt=0 ; cpt<approximations ; ++cpt)
+							{
+								float dx = x[cpt]-px, dy = y[cpt]-py, dz = z[cpt]-pz ;
+								float inverse = 1.0f/::std::sqrt(dx*dx+dy*dy+dz*dz+softening2) ;
+								float factor = mass[cpt]*inverse*inverse*inverse ;
+								ax += dx*factor ; ay += dy*factor ; az += dz*factor ;
+							}
+							for(auto it=list.m_ranges.begin() ; it!=list.m_ranges.end() ; ++it)
+							{
+								for(::std::uint32_t cpt=it->first ; cpt<it->second ; ++cpt)
+								{
+									if(cpt==particle) { continue ; } // No self attraction
+									float dx = positions[cpt][0]-px, dy = positions[cpt][1]-py, dz = positions[cpt][2]-pz ;
+									float inverse = 1.0f/::std::sqrt(dx*dx+dy*dy+dz*dz+softening2) ;
+									float factor = masses[cpt]*inverse*inverse*inverse ;
+									ax += dx*factor ; ay += dy*factor ; az += dz*factor ;
+								}
+							}
+							accelerations[permutation[particle]] = Math::makeVector(ax, ay, az)*gravitationalConstant ;
+						}
+					}
+				}) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	const Math::Vector3f & BarnesHut::acceleration(size_t index) const
+			///
+			/// \brief	Gets the acceleration of a particle computed by computeAccelerations.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	index	The index of the particle in the range given to build.
+			///
+			/// \return	The acceleration.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			const Math::Vector3f & acceleration(size_t index) const
+			{
+				return m_accelerations[index] ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f BarnesHut::operator() (const PonctualMass & mass) const
+			///
+			/// \brief	Force functor interface: computes the attraction exerted on a mass by the particles
+			/// 		of the last build.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	mass	The mass.
+			///
+			/// \return	The force.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f operator() (const PonctualMass & mass) const
+			{
+				return acceleration(mass.m_position)*mass.m_mass ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void BarnesHut::attach(ParticleSystem & system)
+			///
+			/// \brief	Attaches this attraction to a particle system: a system modifier builds the octree
+			/// 		and computes the accelerations, a parallel modifier adds the attraction to the forces
+			/// 		of each particle. The forces must have been reset by a previous modifier and the
+			/// 		integration must be done by a following modifier. This object must outlive the
+			/// 		particle system.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param [in,out]	system	The particle system.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void attach(ParticleSystem & system)
+			{
+				BarnesHut * self = this ;
+				ParticleSystem * particleSystem = &system ;
+				system.addSystemModifier([self](const ParticleSystem::ConstParticleRange & particles, float /*dt*/) 
+				{ 
+					self->build(particles) ; 
+					self->computeAccelerations() ;
+				}) ;
+				system.addModifier([self, particleSystem](Particle & particle, float /*dt*/) 
+				{ 
+					size_t index = &particle-particleSystem->getParticles().begin() ;
+					particle.m_forces += self->acceleration(index)*particle.m_mass ; 
+				}, true) ;
+			}
+		};
+	}
+}
+
+#endif
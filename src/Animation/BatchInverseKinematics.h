@@ -0,0 +1,147 @@
+#ifndef _Animation_BatchInverseKinematics_H
+#define _Animation_BatchInverseKinematics_H
+
+#include <Animation/DampedLeastSquaresIK.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <atomic>
+#include <vector>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	BatchInverseKinematics
+	///
+	/// \brief	Solves the inverse kinematics of many chains concurrently (crowds of articulated
+	/// 		characters). Each problem associates a compiled chain (several problems can share the same
+	/// 		compiled chain: the topology is read only), an extremity, a pose (owned by the caller, one
+	/// 		per problem) and a target. Problems are distributed by blocks of grainSize() on the TBB
+	/// 		worker threads, each block owns one DampedLeastSquaresIK which is rebound to the chains of
+	/// 		the block: the scratch memory is allocated once per block, not per problem.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class BatchInverseKinematics
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Problem
+		///
+		/// \brief	An inverse kinematics problem. m_result is written by the solver.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Problem
+		{
+		public:
+			/// \brief	The compiled chain.
+			const CompiledKinematicChain * m_chain ;
+			/// \brief	The index of the extremity in the compiled chain.
+			int m_extremity ;
+			/// \brief	The offset from the extremity.
+			Math::Vector3f m_offset ;
+			/// \brief	The pose (m_chain->dofs() values), updated by the solver.
+			float * m_pose ;
+			/// \brief	The target.
+			Math::Vector3f m_target ;
+			/// \brief	The result of the last solve.
+			DampedLeastSquaresIK::Result m_result ;
+
+			Problem(const CompiledKinematicChain & chain, int extremity, float * pose, const Math::Vector3f & target, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+				: m_chain(&chain), m_extremity(extremity), m_offset(offset), m_pose(pose), m_target(target)
+			{}
+		};
+
+	protected:
+		/// \brief	The maximum number of iterations per problem.
+		unsigned int m_maxIterations ;
+		/// \brief	The tolerance on the distance to the target.
+		float m_tolerance ;
+		/// \brief	The initial damping of the solvers.
+		float m_damping ;
+		/// \brief	The number of problems per task.
+		size_t m_grainSize ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BatchInverseKinematics::BatchInverseKinematics(unsigned int maxIterations = 50, float tolerance = 0.001f, size_t grainSize = 16)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	maxIterations	(optional) The maximum number of iterations per problem.
+		/// \param	tolerance	 	(optional) The tolerance on the distance to the target.
+		/// \param	grainSize	 	(optional) The number of problems per task.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BatchInverseKinematics(unsigned int maxIterations = 50, float tolerance = 0.001f, size_t grainSize = 16)
+			: m_maxIterations(maxIterations), m_tolerance(tolerance), m_damping(0.1f), m_grainSize(::std::max<size_t>(grainSize, 1))
+		{}
+
+		void setMaxIterations(unsigned int maxIterations)
+		{
+			m_maxIterations = maxIterations ;
+		}
+
+		void setTolerance(float tolerance)
+		{
+			m_tolerance = tolerance ;
+		}
+
+		/// \brief	Sets the initial damping used for each problem.
+		void setDamping(float damping)
+		{
+			m_damping = damping ;
+		}
+
+		size_t grainSize() const
+		{
+			return m_grainSize ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t BatchInverseKinematics::solve(Problem * begin, Problem * end) const
+		///
+		/// \brief	Solves the problems [begin;end) in parallel. Problems must not share their poses.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	begin	The first problem.
+		/// \param	end  	The end of the problems.
+		///
+		/// \return	The number of problems which converged.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t solve(Problem * begin, Problem * end) const
+		{
+			::std::atomic<size_t> converged(0) ;
+			const BatchInverseKinematics & self = *this ;
+			::tbb::parallel_for(::tbb::blocked_range<Problem*>(begin, end, m_grainSize), [&self, &converged](const ::tbb::blocked_range<Problem*> & range)
+			{
+				DampedLeastSquaresIK solver(*range.begin()->m_chain, range.begin()->m_extremity, range.begin()->m_offset) ;
+				size_t localConverged = 0 ;
+				for(Problem * problem=range.begin() ; problem!=range.end() ; ++problem)
+				{
+					solver.setChain(*problem->m_chain, problem->m_extremity, problem->m_offset) ;
+					solver.setDamping(self.m_damping, 0.001f, 100.0f) ;
+					problem->m_result = solver.solve(problem->m_pose, problem->m_target, self.m_maxIterations, self.m_tolerance) ;
+					if(problem->m_result.m_converged) { ++localConverged ; }
+				}
+				converged += localConverged ;
+			}) ;
+			return converged.load() ;
+		}
+
+		/// \brief	Solves all the problems of a vector.
+		size_t solve(::std::vector<Problem> & problems) const
+		{
+			if(problems.empty()) { return 0 ; }
+			return solve(problems.data(), problems.data()+problems.size()) ;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,574 @@
+#ifndef _Animation_CompiledKinematicChain_H
+#define _Animation_CompiledKinematicChain_H
+
+#include <Animation/KinematicChain.h>
+#include <Math/Matrix4x4f.h>
+#include <Math/Vectorf.h>
+#include <Math/Interval.h>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	CompiledKinematicChain
+	///
+	/// \brief	Flattened representation of a kinematic chain. Nodes are stored in topological order
+	/// 		(a father is always stored before its sons) in arrays (joint type, father index, axis,
+	/// 		constant local transformation...) and the degrees of freedom are stored in a float array
+	/// 		(the pose) which is separated from the topology. Forward kinematics, jacobian and inverse
+	/// 		kinematics are tight loops on these arrays, without virtual calls nor allocation.
+	/// 		The compiled chain is built from an existing KinematicChain whose topology must not change
+	/// 		afterwards. Poses can be read from / written to the original chain.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class CompiledKinematicChain
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	AffineTransform
+		///
+		/// \brief	An affine transformation stored as a 3x4 row major matrix.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class AffineTransform
+		{
+		public:
+			float m_data[3][4] ;
+
+			static AffineTransform identity()
+			{
+				AffineTransform result ;
+				for(int row=0 ; row<3 ; ++row)
+				{
+					for(int column=0 ; column<4 ; ++column) { result.m_data[row][column] = (row==column) ? 1.0f : 0.0f ; }
+				}
+				return result ;
+			}
+
+			static AffineTransform fromMatrix(const Math::Matrix4x4f & matrix)
+			{
+				AffineTransform result ;
+				for(int row=0 ; row<3 ; ++row)
+				{
+					for(int column=0 ; column<4 ; ++column) { result.m_data[row][column] = matrix(row, column) ; }
+				}
+				return result ;
+			}
+
+			Math::Matrix4x4f toMatrix() const
+			{
+				Math::Matrix4x4f result = Math::Matrix4x4f::getIdentity() ;
+				for(int row=0 ; row<3 ; ++row)
+				{
+					for(int column=0 ; column<4 ; ++column) { result(row, column) = m_data[row][column] ; }
+				}
+				return result ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void AffineTransform::setRotation(const Math::Vector3f & axis, float angle)
+			///
+			/// \brief	Sets this transformation to the rotation around a normalized axis.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void setRotation(const Math::Vector3f & axis, float angle)
+			{
+				float c = ::std::cos(angle), s = ::std::sin(angle), t = 1.0f-c, x = axis[0], y = axis[1], z = axis[2] ;
+				m_data[0][0] = t*x*x + c ; m_data[0][1] = t*x*y - z*s ; m_data[0][2] = t*x*z + y*s ; m_data[0][3] = 0.0f ;
+				m_data[1][0] = t*x*y + z*s ; m_data[1][1] = t*y*y + c ; m_data[1][2] = t*y*z - x*s ; m_data[1][3] = 0.0f ;
+				m_data[2][0] = t*x*z - y*s ; m_data[2][1] = t*y*z + x*s ; m_data[2][2] = t*z*z + c ; m_data[2][3] = 0.0f ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void AffineTransform::setEulerRotation(float angleX, float angleY, float angleZ)
+			///
+			/// \brief	Sets this transformation to RotationX(angleX).RotationY(angleY).RotationZ(angleZ).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void setEulerRotation(float angleX, float angleY, float angleZ)
+			{
+				float cx = ::std::cos(angleX), sx = ::std::sin(angleX) ;
+				float cy = ::std::cos(angleY), sy = ::std::sin(angleY) ;
+				float cz = ::std::cos(angleZ), sz = ::std::sin(angleZ) ;
+				m_data[0][0] = cy*cz ; m_data[0][1] = -cy*sz ; m_data[0][2] = sy ; m_data[0][3] = 0.0f ;
+				m_data[1][0] = sx*sy*cz + cx*sz ; m_data[1][1] = -sx*sy*sz + cx*cz ; m_data[1][2] = -sx*cy ; m_data[1][3] = 0.0f ;
+				m_data[2][0] = -cx*sy*cz + sx*sz ; m_data[2][1] = cx*sy*sz + sx*cz ; m_data[2][2] = cx*cy ; m_data[2][3] = 0.0f ;
+			}
+
+			void setTranslation(const Math::Vector3f & translation)
+			{
+				*this = identity() ;
+				for(int row=0 ; row<3 ; ++row) { m_data[row][3] = translation[row] ; }
+			}
+
+			AffineTransform operator* (const AffineTransform & other) const
+			{
+				AffineTransform result ;
+				for(int row=0 ; row<3 ; ++row)
+				{
+					for(int column=0 ; column<4 ; ++column)
+					{
+						result.m_data[row][column] = m_data[row][0]*other.m_data[0][column] + m_data[row][1]*other.m_data[1][column] + m_data[row][2]*other.m_data[2][column] ;
+					}
+					result.m_data[row][3] += m_data[row][3] ;
+				}
+				return result ;
+			}
+
+			Math::Vector3f transformPoint(const Math::Vector3f & point) const
+			{
+				return Math::makeVector(m_data[0][0]*point[0] + m_data[0][1]*point[1] + m_data[0][2]*point[2] + m_data[0][3],
+										m_data[1][0]*point[0] + m_data[1][1]*point[1] + m_data[1][2]*point[2] + m_data[1][3],
+										m_data[2][0]*point[0] + m_data[2][1]*point[1] + m_data[2][2]*point[2] + m_data[2][3]) ;
+			}
+
+			Math::Vector3f transformDirection(const Math::Vector3f & direction) const
+			{
+				return Math::makeVector(m_data[0][0]*direction[0] + m_data[0][1]*direction[1] + m_data[0][2]*direction[2],
+										m_data[1][0]*direction[0] + m_data[1][1]*direction[1] + m_data[1][2]*direction[2],
+										m_data[2][0]*direction[0] + m_data[2][1]*direction[1] + m_data[2][2]*direction[2]) ;
+			}
+
+			Math::Vector3f translation() const
+			{
+				return Math::makeVector(m_data[0][3], m_data[1][3], m_data[2][3]) ;
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Workspace
+		///
+		/// \brief	Preallocated memory used by the computations on a compiled chain (local and global
+		/// 		transformations of the nodes, jacobian columns). A workspace must not be shared between
+		/// 		threads.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Workspace
+		{
+		public:
+			/// \brief	The local transformations of the nodes.
+			::std::vector<AffineTransform> m_locals ;
+			/// \brief	The global transformations of the nodes.
+			::std::vector<AffineTransform> m_globals ;
+			/// \brief	The columns of the jacobian (one per degree of freedom).
+			::std::vector<Math::Vector3f> m_columns ;
+
+			Workspace()
+			{}
+
+			Workspace(const CompiledKinematicChain & chain)
+				: m_locals(chain.nodes()), m_globals(chain.nodes()), m_columns(chain.dofs())
+			{}
+
+			/// \brief	Resizes the workspace for a chain (no allocation if the capacity is sufficient).
+			void resize(const CompiledKinematicChain & chain)
+			{
+				m_locals.resize(chain.nodes()) ;
+				m_globals.resize(chain.nodes()) ;
+				m_columns.resize(chain.dofs()) ;
+			}
+		};
+
+	protected:
+		/// \brief	The joint type of each node.
+		::std::vector<KinematicChain::JointType> m_type ;
+		/// \brief	The index of the father of each node (-1 for the root).
+		::std::vector<int> m_father ;
+		/// \brief	The axis of each node (see KinematicChain::Node::getJointAxis).
+		::std::vector<Math::Vector3f> m_axis ;
+		/// \brief	The local transformation of static nodes.
+		::std::vector<AffineTransform> m_staticTransformation ;
+		/// \brief	The index of the first degree of freedom of each node.
+		::std::vector<int> m_firstDof ;
+		/// \brief	The node of each degree of freedom.
+		::std::vector<int> m_dofNode ;
+		/// \brief	The limits of each degree of freedom.
+		::std::vector<Math::Interval<float> > m_limits ;
+		/// \brief	The original nodes.
+		::std::vector<const KinematicChain::Node*> m_nodes ;
+		/// \brief	The original degrees of freedom.
+		::std::vector<KinematicChain::DegreeOfFreedom> m_degreesOfFreedom ;
+
+		void addNode(const KinematicChain::Node * node, int father)
+		{
+			int index = int(m_nodes.size()) ;
+			m_nodes.push_back(node) ;
+			m_type.push_back(node->getJointType()) ;
+			m_father.push_back(father) ;
+			m_axis.push_back(node->getJointAxis()) ;
+			m_staticTransformation.push_back(AffineTransform::fromMatrix(node->getLocalTransformation())) ;
+			m_firstDof.push_back(int(m_degreesOfFreedom.size())) ;
+			for(auto it=node->getDOF().begin(), end=node->getDOF().end() ; it!=end ; ++it)
+			{
+				m_degreesOfFreedom.push_back(*it) ;
+				m_dofNode.push_back(index) ;
+				m_limits.push_back(it->constraint()) ;
+			}
+			for(auto it=node->getSons().begin(), end=node->getSons().end() ; it!=end ; ++it)
+			{
+				addNode(*it, index) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3f CompiledKinematicChain::derivateLocal(int node, const float * values, const Math::Vector3f & point, int dof, const AffineTransform & local) const
+		///
+		/// \brief	Derivative of local(node)*point with respect to the dof-th degree of freedom of the
+		/// 		node (see KinematicChain::Node::derivateLocal). local is the local transformation of the
+		/// 		node for the pose values.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3f derivateLocal(int node, const float * values, const Math::Vector3f & point, int dof, const AffineTransform & local) const
+		{
+			switch(m_type[node])
+			{
+			case KinematicChain::rotationJoint:
+				return m_axis[node]^local.transformDirection(point) ;
+			case KinematicChain::translationJoint:
+				return m_axis[node] ;
+			case KinematicChain::eulerRotationJoint:
+				{
+					const float * angles = values+m_firstDof[node] ;
+					if(dof==0) { return Math::makeVector(1.0f, 0.0f, 0.0f)^local.transformDirection(point) ; }
+					AffineTransform rotationX, rotationY, rotationZ ;
+					rotationX.setEulerRotation(angles[0], 0.0f, 0.0f) ;
+					rotationY.setEulerRotation(0.0f, angles[1], 0.0f) ;
+					rotationZ.setEulerRotation(0.0f, 0.0f, angles[2]) ;
+					Math::Vector3f rotated = rotationZ.transformDirection(point) ;
+					if(dof==1) { return rotationX.transformDirection(Math::makeVector(0.0f, 1.0f, 0.0f)^rotationY.transformDirection(rotated)) ; }
+					return rotationX.transformDirection(rotationY.transformDirection(Math::makeVector(0.0f, 0.0f, 1.0f)^rotated)) ;
+				}
+			default:
+				assert(false) ;
+				return Math::makeVector(0.0f, 0.0f, 0.0f) ;
+			}
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	CompiledKinematicChain::CompiledKinematicChain(const KinematicChain::Node * root)
+		///
+		/// \brief	Compiles the sub tree rooted at root.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	root	The root of the compiled sub tree (usually KinematicChain::getRoot()).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		CompiledKinematicChain(const KinematicChain::Node * root)
+		{
+			addNode(root, -1) ;
+		}
+
+		/// \brief	Number of nodes.
+		size_t nodes() const
+		{
+			return m_nodes.size() ;
+		}
+
+		/// \brief	Number of degrees of freedom i.e. size of a pose.
+		size_t dofs() const
+		{
+			return m_degreesOfFreedom.size() ;
+		}
+
+		/// \brief	Index of the father of a node (-1 for the root).
+		int father(int node) const
+		{
+			return m_father[node] ;
+		}
+
+		/// \brief	Joint type of a node.
+		KinematicChain::JointType jointType(int node) const
+		{
+			return m_type[node] ;
+		}
+
+		/// \brief	Axis of a node (see KinematicChain::Node::getJointAxis).
+		const Math::Vector3f & axis(int node) const
+		{
+			return m_axis[node] ;
+		}
+
+		/// \brief	Index of the first degree of freedom of a node.
+		int firstDof(int node) const
+		{
+			return m_firstDof[node] ;
+		}
+
+		/// \brief	Number of degrees of freedom of a node.
+		int dofCount(int node) const
+		{
+			return ((size_t(node+1)<m_nodes.size()) ? m_firstDof[node+1] : int(m_degreesOfFreedom.size()))-m_firstDof[node] ;
+		}
+
+		/// \brief	Index of the node of a degree of freedom.
+		int dofNode(int dof) const
+		{
+			return m_dofNode[dof] ;
+		}
+
+		/// \brief	Limits of a degree of freedom.
+		const Math::Interval<float> & limits(int dof) const
+		{
+			return m_limits[dof] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int CompiledKinematicChain::index(const KinematicChain::Node * node) const
+		///
+		/// \brief	Gets the index of a node of the original chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The index of the node, -1 if the node has not been compiled.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int index(const KinematicChain::Node * node) const
+		{
+			auto it = ::std::find(m_nodes.begin(), m_nodes.end(), node) ;
+			if(it==m_nodes.end()) { return -1 ; }
+			return int(it-m_nodes.begin()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::readPose(float * values) const
+		///
+		/// \brief	Reads the current values of the degrees of freedom of the original chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	values	The pose (dofs() values).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void readPose(float * values) const
+		{
+			for(size_t cpt=0 ; cpt<m_degreesOfFreedom.size() ; ++cpt) { values[cpt] = m_degreesOfFreedom[cpt] ; }
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::writePose(const float * values)
+		///
+		/// \brief	Writes a pose in the degrees of freedom of the original chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	values	The pose (dofs() values).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void writePose(const float * values)
+		{
+			for(size_t cpt=0 ; cpt<m_degreesOfFreedom.size() ; ++cpt) { m_degreesOfFreedom[cpt] = values[cpt] ; }
+		}
+
+		/// \brief	Writes one degree of freedom of the original chain.
+		void writeDegreeOfFreedom(int dof, float value)
+		{
+			m_degreesOfFreedom[dof] = value ;
+		}
+
+		/// \brief	Clamps the values of a pose to the limits of the degrees of freedom.
+		void clamp(float * values) const
+		{
+			for(size_t cpt=0 ; cpt<m_limits.size() ; ++cpt) { values[cpt] = m_limits[cpt].clamp(values[cpt]) ; }
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::localTransformation(int node, const float * values, AffineTransform & result) const
+		///
+		/// \brief	Computes the local transformation of a node for a given pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void localTransformation(int node, const float * values, AffineTransform & result) const
+		{
+			const float * dof = values+m_firstDof[node] ;
+			switch(m_type[node])
+			{
+			case KinematicChain::rotationJoint:
+				result.setRotation(m_axis[node], dof[0]) ;
+				break ;
+			case KinematicChain::eulerRotationJoint:
+				result.setEulerRotation(dof[0], dof[1], dof[2]) ;
+				break ;
+			case KinematicChain::translationJoint:
+				result.setTranslation(m_axis[node]*dof[0]) ;
+				break ;
+			default:
+				result = m_staticTransformation[node] ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::forwardKinematics(const float * values, Workspace & workspace, int firstNode = 0) const
+		///
+		/// \brief	Computes the local and global transformations of all the nodes for a given pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	values   	The pose.
+		/// \param [in,out]	workspace	The workspace receiving the transformations.
+		/// \param 		 	firstNode	(optional) Only the nodes from firstNode are updated (this includes all
+		/// 							the descendants of firstNode), the other transformations must be up to date.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void forwardKinematics(const float * values, Workspace & workspace, int firstNode = 0) const
+		{
+			assert(workspace.m_globals.size()==m_nodes.size()) ;
+			for(size_t node=size_t(firstNode) ; node<m_nodes.size() ; ++node)
+			{
+				localTransformation(int(node), values, workspace.m_locals[node]) ;
+				int father = m_father[node] ;
+				if(father<0) { workspace.m_globals[node] = workspace.m_locals[node] ; }
+				else { workspace.m_globals[node] = workspace.m_globals[father]*workspace.m_locals[node] ; }
+			}
+		}
+
+		/// \brief	Position of a point (offset in the frame of node) after forwardKinematics.
+		Math::Vector3f position(const Workspace & workspace, int node, const Math::Vector3f & offset) const
+		{
+			return workspace.m_globals[node].transformPoint(offset) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::jacobian(const float * values, const Workspace & workspace, int node, const Math::Vector3f & offset, Math::Vector3f * columns) const
+		///
+		/// \brief	Computes the analytic jacobian of the position of node (with offset offset) in one sweep
+		/// 		from node to the root. forwardKinematics must have been called with the same pose.
+		/// 		columns[i] receives the derivative with respect to the i-th degree of freedom (null if
+		/// 		it does not belong to an ancestor of node).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	values   	The pose.
+		/// \param	workspace	The workspace containing the transformations.
+		/// \param	node	 	The node.
+		/// \param	offset   	The offset in the frame of the node.
+		/// \param	columns  	The columns of the jacobian (dofs() vectors).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void jacobian(const float * values, const Workspace & workspace, int node, const Math::Vector3f & offset, Math::Vector3f * columns) const
+		{
+			::std::fill(columns, columns+m_degreesOfFreedom.size(), Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+			Math::Vector3f point = offset ;
+			for( ; node>=0 ; node=m_father[node])
+			{
+				int first = m_firstDof[node] ;
+				int last = first+dofCount(node) ;
+				int father = m_father[node] ;
+				for(int dof=first ; dof<last ; ++dof)
+				{
+					Math::Vector3f derivative = derivateLocal(node, values, point, dof-first, workspace.m_locals[node]) ;
+					columns[dof] = (father<0) ? derivative : workspace.m_globals[father].transformDirection(derivative) ;
+				}
+				point = workspace.m_locals[node].transformPoint(point) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void CompiledKinematicChain::angularJacobian(const float * values, const Workspace & workspace, int node, Math::Vector3f * columns) const
+		///
+		/// \brief	Computes the angular jacobian of the orientation of node: the column of a rotational
+		/// 		degree of freedom is its rotation axis in the global frame (angular velocity for a unit
+		/// 		derivative), the other columns are null. forwardKinematics must have been called with
+		/// 		the same pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	values   	The pose.
+		/// \param	workspace	The workspace containing the forward kinematics of the pose.
+		/// \param	node	 	The node.
+		/// \param	columns  	The columns (dofs() vectors).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void angularJacobian(const float * values, const Workspace & workspace, int node, Math::Vector3f * columns) const
+		{
+			::std::fill(columns, columns+m_degreesOfFreedom.size(), Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+			for( ; node>=0 ; node=m_father[node])
+			{
+				int first = m_firstDof[node] ;
+				int father = m_father[node] ;
+				AffineTransform frame = (father<0) ? AffineTransform::identity() : workspace.m_globals[father] ;
+				switch(m_type[node])
+				{
+				case KinematicChain::rotationJoint:
+					columns[first] = frame.transformDirection(m_axis[node].normalized()) ;
+					break ;
+				case KinematicChain::eulerRotationJoint:
+					{
+						// RotationX.RotationY.RotationZ: the axis of each rotation is transformed by the previous ones
+						AffineTransform rotationX, rotationXY ;
+						rotationX.setEulerRotation(values[first], 0.0f, 0.0f) ;
+						rotationXY.setEulerRotation(values[first], values[first+1], 0.0f) ;
+						columns[first] = frame.transformDirection(Math::makeVector(1.0f, 0.0f, 0.0f)) ;
+						columns[first+1] = frame.transformDirection(rotationX.transformDirection(Math::makeVector(0.0f, 1.0f, 0.0f))) ;
+						columns[first+2] = frame.transformDirection(rotationXY.transformDirection(Math::makeVector(0.0f, 0.0f, 1.0f))) ;
+					}
+					break ;
+				default:
+					break ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float CompiledKinematicChain::convergeToward(float * values, Workspace & workspace, int node, const Math::Vector3f & offset, const Math::Vector3f & target, float maxDeltaAngle) const
+		///
+		/// \brief	One iteration of jacobian transpose inverse kinematics, with the optimal step along the
+		/// 		transposed direction. The pose is updated and clamped to the limits.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	values	 	The pose.
+		/// \param [in,out]	workspace	The workspace, contains the forward kinematics of the updated pose
+		/// 							on return.
+		/// \param 		 	node	 	The extremity.
+		/// \param 		 	offset   	The offset from the extremity.
+		/// \param 		 	target   	The target.
+		/// \param 		 	maxDeltaAngle	The maximum variation of a degree of freedom.
+		///
+		/// \return	The distance between the extremity and the target after the iteration.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float convergeToward(float * values, Workspace & workspace, int node, const Math::Vector3f & offset, const Math::Vector3f & target, float maxDeltaAngle) const
+		{
+			forwardKinematics(values, workspace) ;
+			Math::Vector3f error = target-position(workspace, node, offset) ;
+			Math::Vector3f * columns = workspace.m_columns.data() ;
+			jacobian(values, workspace, node, offset, columns) ;
+			// J.J^t.error
+			Math::Vector3f projected = Math::makeVector(0.0f, 0.0f, 0.0f) ;
+			for(size_t dof=0 ; dof<m_degreesOfFreedom.size() ; ++dof) { projected += columns[dof]*(columns[dof]*error) ; }
+			float norm2 = projected.norm2() ;
+			if(norm2>0.0f)
+			{
+				float step = (error*projected)/norm2 ;
+				for(size_t dof=0 ; dof<m_degreesOfFreedom.size() ; ++dof)
+				{
+					float delta = ::std::max(-maxDeltaAngle, ::std::min(maxDeltaAngle, step*(columns[dof]*error))) ;
+					values[dof] = m_limits[dof].clamp(values[dof]+delta) ;
+				}
+			}
+			forwardKinematics(values, workspace) ;
+			return (target-position(workspace, node, offset)).norm() ;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef _Animation_DampedLeastSquaresIK_H
+#define _Animation_DampedLeastSquaresIK_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Math/Ldlt.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	DampedLeastSquaresIK
+	///
+	/// \brief	Damped least squares (Levenberg-Marquardt) inverse kinematics on a compiled kinematic
+	/// 		chain. Each iteration computes dTheta = Jt.(J.Jt + lambda^2.I)^-1.error where J is the 3xN
+	/// 		analytic jacobian of the extremity: the 3x3 normal equations are solved with a LDLt
+	/// 		decomposition (no SVD). The damping adapts to the conditioning of the problem: it decreases
+	/// 		when an iteration reduces the error and increases (the iteration being rejected) otherwise,
+	/// 		which typically occurs near singularities. All the memory is allocated by the constructor,
+	/// 		an iteration costs one forward kinematics, the jacobian and J.Jt are only recomputed
+	/// 		after an accepted iteration (a rejected iteration only increases the damping).
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class DampedLeastSquaresIK
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Result
+		///
+		/// \brief	Result of a call to solve.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Result
+		{
+		public:
+			/// \brief	The number of iterations.
+			unsigned int m_iterations ;
+			/// \brief	The distance between the extremity and the target.
+			float m_residual ;
+			/// \brief	true if the residual is below the tolerance.
+			bool m_converged ;
+
+			Result()
+				: m_iterations(0), m_residual(0.0f), m_converged(false)
+			{}
+		};
+
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The index of the extremity in the compiled chain.
+		int m_extremity ;
+		/// \brief	The offset from the extremity.
+		Math::Vector3f m_offset ;
+		/// \brief	Forward kinematics of the current pose.
+		CompiledKinematicChain::Workspace m_current ;
+		/// \brief	Forward kinematics of the tried pose.
+		CompiledKinematicChain::Workspace m_trial ;
+		/// \brief	The tried pose.
+		::std::vector<float> m_trialPose ;
+		/// \brief	The damping factor (lambda).
+		float m_damping ;
+		/// \brief	The minimum and maximum values of the damping factor.
+		float m_minDamping, m_maxDamping ;
+		/// \brief	The maximum norm of the error used by an iteration.
+		float m_maxStep ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	DampedLeastSquaresIK::DampedLeastSquaresIK(const CompiledKinematicChain & chain, int extremity,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive this object).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	offset   	(optional) The offset from the extremity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		DampedLeastSquaresIK(const CompiledKinematicChain & chain, int extremity, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+			: m_chain(&chain), m_extremity(extremity), m_offset(offset), m_current(chain), m_trial(chain), m_trialPose(chain.dofs()),
+			  m_damping(0.1f), m_minDamping(0.001f), m_maxDamping(100.0f), m_maxStep(::std::numeric_limits<float>::max())
+		{
+			assert(extremity>=0 && size_t(extremity)<chain.nodes()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void DampedLeastSquaresIK::setDamping(float initial, float minimum, float maximum)
+		///
+		/// \brief	Sets the damping factor and its bounds.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setDamping(float initial, float minimum, float maximum)
+		{
+			assert(minimum>0.0f && minimum<=maximum) ;
+			m_minDamping = minimum ;
+			m_maxDamping = maximum ;
+			m_damping = ::std::max(minimum, ::std::min(maximum, initial)) ;
+		}
+
+		/// \brief	Sets the maximum norm of the error used by an iteration (the error is clamped).
+		void setMaxStep(float maxStep)
+		{
+			m_maxStep = maxStep ;
+		}
+
+		/// \brief	Gets the current damping factor.
+		float damping() const
+		{
+			return m_damping ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void DampedLeastSquaresIK::setChain(const CompiledKinematicChain & chain, int extremity,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Binds the solver to another chain. The buffers are reused, memory is only allocated if
+		/// 		the new chain is bigger than the previous ones.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setChain(const CompiledKinematicChain & chain, int extremity, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		{
+			assert(extremity>=0 && size_t(extremity)<chain.nodes()) ;
+			m_chain = &chain ;
+			m_extremity = extremity ;
+			m_offset = offset ;
+			m_current.resize(chain) ;
+			m_trial.resize(chain) ;
+			m_trialPose.resize(chain.dofs()) ;
+		}
+
+		/// \brief	Gets the index of the extremity.
+		int extremity() const
+		{
+			return m_extremity ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Result DampedLeastSquaresIK::solve(float * pose, const Math::Vector3f & target,
+		/// 	unsigned int maxIterations, float tolerance)
+		///
+		/// \brief	Moves the extremity toward the target.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose		 	The pose (updated).
+		/// \param 		 	target		 	The target.
+		/// \param 		 	maxIterations	The maximum number of iterations.
+		/// \param 		 	tolerance	 	The distance under which the target is reached.
+		///
+		/// \return	The number of iterations and the residual.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Result solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations, float tolerance)
+		{
+			const size_t dofs = m_chain->dofs() ;
+			Result result ;
+			m_chain->forwardKinematics(pose, m_current) ;
+			Math::Vector3f error = target-m_chain->position(m_current, m_extremity, m_offset) ;
+			float residual = error.norm() ;
+			// J.Jt of the current pose (lower part), valid until an iteration is accepted
+			double jjt[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } } ;
+			bool jacobianValid = false ;
+			while(residual>tolerance && result.m_iterations<maxIterations)
+			{
+				++result.m_iterations ;
+				Math::Vector3f * columns = m_current.m_columns.data() ;
+				if(!jacobianValid)
+				{
+					m_chain->jacobian(pose, m_current, m_extremity, m_offset, columns) ;
+					for(int row=0 ; row<3 ; ++row)
+					{
+						for(int cpt=0 ; cpt<=row ; ++cpt) { jjt[row][cpt] = 0.0 ; }
+					}
+					for(size_t dof=0 ; dof<dofs ; ++dof)
+					{
+						const Math::Vector3f & column = columns[dof] ;
+						for(int row=0 ; row<3 ; ++row)
+						{
+							for(int cpt=0 ; cpt<=row ; ++cpt) { jjt[row][cpt] += double(column[row])*double(column[cpt]) ; }
+						}
+					}
+					jacobianValid = true ;
+				}
+				// Normal equations (J.Jt + lambda^2.I).y = error, only the lower part is used
+				double normal[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } } ;
+				for(int row=0 ; row<3 ; ++row)
+				{
+					for(int cpt=0 ; cpt<=row ; ++cpt) { normal[row][cpt] = jjt[row][cpt] ; }
+				}
+				double damping2 = double(m_damping)*double(m_damping) ;
+				for(int row=0 ; row<3 ; ++row) { normal[row][row] += damping2 ; }
+				Math::Vector3f clamped = (residual>m_maxStep) ? error*(m_maxStep/residual) : error ;
+				double y[3] = { clamped[0], clamped[1], clamped[2] } ;
+				if(!Math::ldltDecompose(&normal[0][0], 3))
+				{
+					// Can not happen with a strictly positive damping except with degenerate values
+					break ;
+				}
+				Math::ldltSolve(&normal[0][0], y, 3) ;
+				// dTheta = Jt.y
+				Math::Vector3f direction = Math::makeVector(float(y[0]), float(y[1]), float(y[2])) ;
+				for(size_t dof=0 ; dof<dofs ; ++dof)
+				{
+					m_trialPose[dof] = m_chain->limits(int(dof)).clamp(pose[dof]+columns[dof]*direction) ;
+				}
+				m_chain->forwardKinematics(m_trialPose.data(), m_trial) ;
+				Math::Vector3f trialError = target-m_chain->position(m_trial, m_extremity, m_offset) ;
+				float trialResidual = trialError.norm() ;
+				if(trialResidual<residual)
+				{
+					::std::copy(m_trialPose.begin(), m_trialPose.end(), pose) ;
+					::std::swap(m_current, m_trial) ;
+					error = trialError ;
+					residual = trialResidual ;
+					m_damping = ::std::max(m_minDamping, m_damping*0.5f) ;
+					jacobianValid = false ;
+				}
+				else
+				{
+					// The iteration is rejected, the damping increases (stuck if already maximal). The
+					// pose is unchanged: the jacobian and the error are kept
+					if(m_damping>=m_maxDamping) { break ; }
+					m_damping = ::std::min(m_maxDamping, m_damping*4.0f) ;
+				}
+			}
+			result.m_residual = residual ;
+			result.m_converged = residual<=tolerance ;
+			return result ;
+		}
+	};
+}
+
+#endif
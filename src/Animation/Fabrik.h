@@ -0,0 +1,277 @@
+#ifndef _Animation_Fabrik_H
+#define _Animation_Fabrik_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Animation/DampedLeastSquaresIK.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Fabrik
+	///
+	/// \brief	FABRIK (Forward And Backward Reaching Inverse Kinematics) solver on a compiled kinematic
+	/// 		chain. The joint positions of the path from the root to the extremity are extracted from
+	/// 		the forward kinematics (consecutive nodes sharing the same position form one joint), the
+	/// 		FABRIK passes move these positions toward the target while keeping the segment lengths.
+	/// 		The new positions are then projected on the degrees of freedom: from the root to the
+	/// 		extremity, each rotation (Rotation and the three axes of EulerRotation) takes the angle
+	/// 		minimizing the sum of the squared distances between all the following joints and their
+	/// 		FABRIK positions (a least squares fit around the rotation axis, see rotateToward), the
+	/// 		angle being clamped to the limits of the degree of freedom. Translation degrees of
+	/// 		freedom are not modified. No jacobian is needed and the memory is allocated by the
+	/// 		constructor.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Fabrik
+	{
+	public:
+		typedef DampedLeastSquaresIK::Result Result ;
+
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The index of the extremity in the compiled chain.
+		int m_extremity ;
+		/// \brief	The offset from the extremity.
+		Math::Vector3f m_offset ;
+		/// \brief	The nodes from the root to the extremity.
+		::std::vector<int> m_path ;
+		/// \brief	For each node of the path, the index of the joint at its origin.
+		::std::vector<int> m_nodeJoint ;
+		/// \brief	The positions of the joints computed by FABRIK.
+		::std::vector<Math::Vector3f> m_joints ;
+		/// \brief	The first node of the path associated with each joint (the extremity with its offset
+		/// 		may be an additional joint).
+		::std::vector<int> m_jointNodes ;
+		/// \brief	The lengths of the segments between the joints.
+		::std::vector<float> m_lengths ;
+		/// \brief	The forward kinematics of the pose.
+		CompiledKinematicChain::Workspace m_workspace ;
+		/// \brief	The pose before the current iteration (restored if the iteration does not improve it).
+		::std::vector<float> m_previousPose ;
+
+		/// \brief	Position of a joint for the current forward kinematics (the last joint is the extremity).
+		Math::Vector3f jointPosition(int joint) const
+		{
+			if(size_t(joint)<m_jointNodes.size()) { return m_workspace.m_globals[m_jointNodes[joint]].translation() ; }
+			return m_chain->position(m_workspace, m_extremity, m_offset) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Fabrik::extractJoints()
+		///
+		/// \brief	Extracts the joints and the segment lengths from the current forward kinematics.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void extractJoints()
+		{
+			m_joints.clear() ;
+			m_jointNodes.clear() ;
+			m_lengths.clear() ;
+			for(size_t cpt=0 ; cpt<m_path.size() ; ++cpt)
+			{
+				Math::Vector3f position = m_workspace.m_globals[m_path[cpt]].translation() ;
+				if(m_joints.empty() || (position-m_joints.back()).norm()>1e-6f)
+				{
+					if(!m_joints.empty()) { m_lengths.push_back((position-m_joints.back()).norm()) ; }
+					m_joints.push_back(position) ;
+					m_jointNodes.push_back(m_path[cpt]) ;
+				}
+				m_nodeJoint[cpt] = int(m_joints.size())-1 ;
+			}
+			Math::Vector3f extremity = m_chain->position(m_workspace, m_extremity, m_offset) ;
+			if((extremity-m_joints.back()).norm()>1e-6f)
+			{
+				m_lengths.push_back((extremity-m_joints.back()).norm()) ;
+				m_joints.push_back(extremity) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Fabrik::reach(const Math::Vector3f & target)
+		///
+		/// \brief	One forward and backward FABRIK pass on the joint positions.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reach(const Math::Vector3f & target)
+		{
+			const size_t last = m_joints.size()-1 ;
+			Math::Vector3f root = m_joints[0] ;
+			// Forward pass: from the extremity to the root
+			m_joints[last] = target ;
+			for(size_t joint=last ; joint>0 ; --joint)
+			{
+				Math::Vector3f direction = m_joints[joint-1]-m_joints[joint] ;
+				float norm = direction.norm() ;
+				if(norm>0.0f) { m_joints[joint-1] = m_joints[joint]+direction*(m_lengths[joint-1]/norm) ; }
+			}
+			// Backward pass: from the root to the extremity
+			m_joints[0] = root ;
+			for(size_t joint=1 ; joint<=last ; ++joint)
+			{
+				Math::Vector3f direction = m_joints[joint]-m_joints[joint-1] ;
+				float norm = direction.norm() ;
+				if(norm>0.0f) { m_joints[joint] = m_joints[joint-1]+direction*(m_lengths[joint-1]/norm) ; }
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Fabrik::rotateToward(float * pose, int node, int dof, const Math::Vector3f & axis, int joint)
+		///
+		/// \brief	Rotates the degree of freedom dof (of node, around the global axis axis) to move the
+		/// 		joints following joint toward their FABRIK positions. The angle minimizes the sum of the
+		/// 		squared distances between the rotated joints and their FABRIK positions (the next
+		/// 		joint alone can not be reached if the rotation axes are constrained, as for hinges).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void rotateToward(float * pose, int node, int dof, Math::Vector3f axis, int joint)
+		{
+			float axisNorm = axis.norm() ;
+			if(axisNorm==0.0f) { return ; }
+			axis = axis/axisNorm ;
+			Math::Vector3f origin = m_workspace.m_globals[node].translation() ;
+			float sine = 0.0f, cosine = 0.0f ;
+			for(size_t next=size_t(joint)+1 ; next<m_joints.size() ; ++next)
+			{
+				Math::Vector3f current = jointPosition(int(next))-origin ;
+				Math::Vector3f desired = m_joints[next]-origin ;
+				current -= axis*(axis*current) ;
+				desired -= axis*(axis*desired) ;
+				sine += axis*(current^desired) ;
+				cosine += current*desired ;
+			}
+			if(sine==0.0f && cosine==0.0f) { return ; }
+			float angle = ::std::atan2(sine, cosine) ;
+			float value = m_chain->limits(dof).clamp(pose[dof]+angle) ;
+			if(value==pose[dof]) { return ; }
+			pose[dof] = value ;
+			m_chain->forwardKinematics(pose, m_workspace, node) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Fabrik::project(float * pose)
+		///
+		/// \brief	Projects the FABRIK joint positions on the rotational degrees of freedom.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void project(float * pose)
+		{
+			for(size_t cpt=0 ; cpt<m_path.size() ; ++cpt)
+			{
+				int node = m_path[cpt] ;
+				int joint = m_nodeJoint[cpt] ;
+				if(size_t(joint)+1>=m_joints.size()) { continue ; }
+				int father = m_chain->father(node) ;
+				int first = m_chain->firstDof(node) ;
+				CompiledKinematicChain::AffineTransform frame = (father<0) ? CompiledKinematicChain::AffineTransform::identity() : m_workspace.m_globals[father] ;
+				switch(m_chain->jointType(node))
+				{
+				case KinematicChain::rotationJoint:
+					rotateToward(pose, node, first, frame.transformDirection(m_chain->axis(node)), joint) ;
+					break ;
+				case KinematicChain::eulerRotationJoint:
+					{
+						// Rx.Ry.Rz: the axis of each rotation is transformed by the previous ones
+						for(int axis=0 ; axis<3 ; ++axis)
+						{
+							CompiledKinematicChain::AffineTransform partial ;
+							partial.setEulerRotation(axis>0 ? pose[first] : 0.0f, axis>1 ? pose[first+1] : 0.0f, 0.0f) ;
+							Math::Vector3f localAxis = Math::makeVector(axis==0 ? 1.0f : 0.0f, axis==1 ? 1.0f : 0.0f, axis==2 ? 1.0f : 0.0f) ;
+							rotateToward(pose, node, first+axis, (frame*partial).transformDirection(localAxis), joint) ;
+						}
+					}
+					break ;
+				default:
+					break ;
+				}
+			}
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Fabrik::Fabrik(const CompiledKinematicChain & chain, int extremity,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive this object).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	offset   	(optional) The offset from the extremity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Fabrik(const CompiledKinematicChain & chain, int extremity, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+			: m_chain(&chain), m_extremity(extremity), m_offset(offset), m_workspace(chain), m_previousPose(chain.dofs())
+		{
+			assert(extremity>=0 && size_t(extremity)<chain.nodes()) ;
+			for(int node=extremity ; node>=0 ; node=chain.father(node)) { m_path.push_back(node) ; }
+			::std::reverse(m_path.begin(), m_path.end()) ;
+			m_nodeJoint.resize(m_path.size()) ;
+			m_joints.reserve(m_path.size()+1) ;
+			m_jointNodes.reserve(m_path.size()) ;
+			m_lengths.reserve(m_path.size()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Result Fabrik::solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations,
+		/// 	float tolerance)
+		///
+		/// \brief	Moves the extremity toward the target. An iteration is a FABRIK pass followed by the
+		/// 		projection on the degrees of freedom. An iteration which does not reduce the distance
+		/// 		to the target is undone and stops the solver.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose		 	The pose (updated).
+		/// \param 		 	target		 	The target.
+		/// \param 		 	maxIterations	The maximum number of iterations.
+		/// \param 		 	tolerance	 	The distance under which the target is reached.
+		///
+		/// \return	The number of iterations and the residual.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Result solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations, float tolerance)
+		{
+			Result result ;
+			m_chain->forwardKinematics(pose, m_workspace) ;
+			float residual = (target-m_chain->position(m_workspace, m_extremity, m_offset)).norm() ;
+			while(residual>tolerance && result.m_iterations<maxIterations)
+			{
+				++result.m_iterations ;
+				extractJoints() ;
+				if(m_joints.size()<2) { break ; }
+				::std::copy(pose, pose+m_previousPose.size(), m_previousPose.begin()) ;
+				reach(target) ;
+				project(pose) ;
+				float previous = residual ;
+				residual = (target-m_chain->position(m_workspace, m_extremity, m_offset)).norm() ;
+				// Stalled (limits or unreachable target): the previous pose is kept
+				if(residual>=previous)
+				{
+					::std::copy(m_previousPose.begin(), m_previousPose.end(), pose) ;
+					residual = previous ;
+					break ;
+				}
+			}
+			result.m_residual = residual ;
+			result.m_converged = residual<=tolerance ;
+			return result ;
+		}
+	};
+}
+
+#endif
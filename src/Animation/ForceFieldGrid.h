@@ -0,0 +1,371 @@
+#ifndef _Animation_ForceFieldGrid_H
+#define _Animation_ForceFieldGrid_H
+
+#include <Animation/PonctualMass.h>
+#include <Math/Vectorf.h>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <tbb/parallel_for.h>
+
+namespace Animation
+{
+	namespace Physics
+	{
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	ForceFieldGrid
+		///
+		/// \brief	A force field baked in a regular 3D grid and sampled with trilinear interpolation. The
+		/// 		grid stores accelerations (forces per unit of mass): it can be filled from any force
+		/// 		functor (see Physics.h), from a function of the position or from procedural noise
+		/// 		(curl noise), and fields can be accumulated: a complex field (wind + turbulence +
+		/// 		vortices...) costs the same as one lookup. The grid is itself a force functor:
+		/// 		Math::Vector3f (const PonctualMass &) returns the sampled acceleration times the mass,
+		/// 		and can replace the baked functors in modifiers or force functions. Outside of the
+		/// 		grid, the value of the closest point of the grid is used.
+		/// 		Each node stores 4 floats (the fourth one is 0) so that the interpolation of the 8
+		/// 		corners is done with 4 wide vector operations.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class ForceFieldGrid
+		{
+		protected:
+			/// \brief	The lower corner of the grid.
+			Math::Vector3f m_min ;
+			/// \brief	The upper corner of the grid.
+			Math::Vector3f m_max ;
+			/// \brief	The number of nodes on each axis.
+			int m_resolution[3] ;
+			/// \brief	The inverse of the cell size on each axis.
+			Math::Vector3f m_inverseCellSize ;
+			/// \brief	The values of the nodes (4 floats per node, x varies first).
+			::std::vector<float> m_values ;
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	size_t ForceFieldGrid::nodeIndex(int x, int y, int z) const
+			///
+			/// \brief	Gets the index of a node.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			size_t nodeIndex(int x, int y, int z) const
+			{
+				return ((size_t)z*m_resolution[1]+y)*m_resolution[0]+x ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	static float ForceFieldGrid::latticeValue(int x, int y, int z, int component, ::std::uint64_t seed)
+			///
+			/// \brief	Pseudo random value in [-1;1] associated to a point of the integer lattice (hash).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			static float latticeValue(int x, int y, int z, int component, ::std::uint64_t seed)
+			{
+				::std::uint64_t h = seed ^ ((::std::uint64_t)(::std::uint32_t)x*0x9e3779b97f4a7c15ull) ;
+				h ^= (::std::uint64_t)(::std::uint32_t)y*0xc2b2ae3d27d4eb4full ;
+				h ^= (::std::uint64_t)(::std::uint32_t)z*0x165667b19e3779f9ull ;
+				h ^= (::std::uint64_t)component*0xd6e8feb86659fd93ull ;
+				h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull ;
+				h = (h ^ (h >> 27)) * 0x94d049bb133111ebull ;
+				h ^= h >> 31 ;
+				return float(h >> 40) * (2.0f / 16777216.0f) - 1.0f ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	static Math::Vector3f ForceFieldGrid::valueNoise(const Math::Vector3f & position, ::std::uint64_t seed)
+			///
+			/// \brief	Vector valued noise: random vectors of the integer lattice interpolated with a
+			/// 		smoothstep.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			static Math::Vector3f valueNoise(const Math::Vector3f & position, ::std::uint64_t seed)
+			{
+				int cell[3] ;
+				float weight[3] ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					float base = ::std::floor(position[axis]) ;
+					float t = position[axis]-base ;
+					cell[axis] = (int)base ;
+					weight[axis] = t*t*(3.0f-2.0f*t) ;
+				}
+				Math::Vector3f result = Math::makeVector(0.0f, 0.0f, 0.0f) ;
+				for(int corner=0 ; corner<8 ; ++corner)
+				{
+					int dx = corner&1, dy = (corner>>1)&1, dz = (corner>>2)&1 ;
+					float w = (dx ? weight[0] : 1.0f-weight[0])*(dy ? weight[1] : 1.0f-weight[1])*(dz ? weight[2] : 1.0f-weight[2]) ;
+					for(int component=0 ; component<3 ; ++component)
+					{
+						result[component] += w*latticeValue(cell[0]+dx, cell[1]+dy, cell[2]+dz, component, seed) ;
+					}
+				}
+				return result ;
+			}
+
+		public:
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	ForceFieldGrid::ForceFieldGrid(const Math::Vector3f & min, const Math::Vector3f & max,
+			/// 	int resolutionX, int resolutionY, int resolutionZ)
+			///
+			/// \brief	Constructor. The field is initialized to 0.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	min		   	The lower corner of the grid.
+			/// \param	max		   	The upper corner of the grid.
+			/// \param	resolutionX	The number of nodes on the x axis (at least 2).
+			/// \param	resolutionY	The number of nodes on the y axis (at least 2).
+			/// \param	resolutionZ	The number of nodes on the z axis (at least 2).
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			ForceFieldGrid(const Math::Vector3f & min, const Math::Vector3f & max, int resolutionX, int resolutionY, int resolutionZ)
+				: m_min(min), m_max(max)
+			{
+				m_resolution[0] = ::std::max(resolutionX, 2) ;
+				m_resolution[1] = ::std::max(resolutionY, 2) ;
+				m_resolution[2] = ::std::max(resolutionZ, 2) ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					assert(max[axis]>min[axis]) ;
+					m_inverseCellSize[axis] = (m_resolution[axis]-1)/(max[axis]-min[axis]) ;
+				}
+				m_values.resize((size_t)m_resolution[0]*m_resolution[1]*m_resolution[2]*4, 0.0f) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f ForceFieldGrid::nodePosition(int x, int y, int z) const
+			///
+			/// \brief	Gets the position of a node.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f nodePosition(int x, int y, int z) const
+			{
+				return Math::makeVector(m_min[0]+x/m_inverseCellSize[0], m_min[1]+y/m_inverseCellSize[1], m_min[2]+z/m_inverseCellSize[2]) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void ForceFieldGrid::clear()
+			///
+			/// \brief	Resets the field to 0.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void clear()
+			{
+				::std::fill(m_values.begin(), m_values.end(), 0.0f) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	template <class Function> void ForceFieldGrid::add(const Function & function)
+			///
+			/// \brief	Adds an acceleration field given by a function of the position to the grid. The
+			/// 		function is evaluated in parallel on the nodes.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \tparam	Function	Type of the function: Math::Vector3f (const Math::Vector3f & position).
+			/// \param	function	The function.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			template <class Function>
+			void add(const Function & function)
+			{
+				float * values = m_values.data() ;
+				::tbb::parallel_for(0, m_resolution[2], [this, &function, values](int z)
+				{
+					for(int y=0 ; y<m_resolution[1] ; ++y)
+					{
+						for(int x=0 ; x<m_resolution[0] ; ++x)
+						{
+							Math::Vector3f value = function(nodePosition(x, y, z)) ;
+							float * node = values+nodeIndex(x, y, z)*4 ;
+							node[0] += value[0] ; node[1] += value[1] ; node[2] += value[2] ;
+						}
+					}
+				}) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	template <class Force> void ForceFieldGrid::addForce(const Force & force, float mass = 1.0f)
+			///
+			/// \brief	Adds a force functor to the grid (WeightForce, AttractionForce...). The force is
+			/// 		evaluated on a probe mass placed on each node, with a null speed and a null force,
+			/// 		and stored divided by the mass of the probe: the baked field is exact for forces
+			/// 		proportional to the mass (weight, gravitational attraction). Forces depending on
+			/// 		the speed (DampingForce) cannot be baked.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \tparam	Force	Type of the force: Math::Vector3f (PonctualMass &).
+			/// \param	force	The force.
+			/// \param	mass 	(optional) the mass of the probe.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			template <class Force>
+			void addForce(const Force & force, float mass = 1.0f)
+			{
+				add([&force, mass](const Math::Vector3f & position) -> Math::Vector3f
+				{
+					PonctualMass probe(mass, position) ;
+					return force(probe)/mass ;
+				}) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void ForceFieldGrid::addCurlNoise(float amplitude, float frequency, ::std::uint64_t seed = 0)
+			///
+			/// \brief	Adds turbulence to the field: curl of a vector valued noise (an acceleration). The resulting field is
+			/// 		divergence free (no sink nor source), its magnitude is close to amplitude. The curl
+			/// 		is computed with finite differences on the grid, features smaller than a cell are
+			/// 		lost.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	amplitude	The amplitude of the turbulence.
+			/// \param	frequency	The spatial frequency of the noise (1/size of the vortices).
+			/// \param	seed	 	(optional) the seed of the noise.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void addCurlNoise(float amplitude, float frequency, ::std::uint64_t seed = 0)
+			{
+				// Potential sampled on the nodes
+				::std::vector<Math::Vector3f> potential((size_t)m_resolution[0]*m_resolution[1]*m_resolution[2]) ;
+				Math::Vector3f * potentialValues = potential.data() ;
+				::tbb::parallel_for(0, m_resolution[2], [this, potentialValues, frequency, seed](int z)
+				{
+					for(int y=0 ; y<m_resolution[1] ; ++y)
+					{
+						for(int x=0 ; x<m_resolution[0] ; ++x)
+						{
+							potentialValues[nodeIndex(x, y, z)] = valueNoise(nodePosition(x, y, z)*frequency, seed) ;
+						}
+					}
+				}) ;
+				// Curl with central differences (one sided on the borders)
+				const float scale = amplitude/frequency ;
+				float * values = m_values.data() ;
+				::tbb::parallel_for(0, m_resolution[2], [this, potentialValues, values, scale](int z)
+				{
+					for(int y=0 ; y<m_resolution[1] ; ++y)
+					{
+						for(int x=0 ; x<m_resolution[0] ; ++x)
+						{
+							int coordinates[3] = { x, y, z } ;
+							Math::Vector3f derivative[3] ; // derivative[axis] = d(potential)/d(axis)
+							for(int axis=0 ; axis<3 ; ++axis)
+							{
+								int low[3] = { x, y, z }, high[3] = { x, y, z } ;
+								low[axis] = ::std::max(coordinates[axis]-1, 0) ;
+								high[axis] = ::std::min(coordinates[axis]+1, m_resolution[axis]-1) ;
+								float delta = (high[axis]-low[axis])/m_inverseCellSize[axis] ;
+								derivative[axis] = (potentialValues[nodeIndex(high[0], high[1], high[2])]-potentialValues[nodeIndex(low[0], low[1], low[2])])/delta ;
+							}
+							float * node = values+nodeIndex(x, y, z)*4 ;
+							node[0] += scale*(derivative[1][2]-derivative[2][1]) ;
+							node[1] += scale*(derivative[2][0]-derivative[0][2]) ;
+							node[2] += scale*(derivative[0][1]-derivative[1][0]) ;
+						}
+					}
+				}) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f ForceFieldGrid::sample(const Math::Vector3f & position) const
+			///
+			/// \brief	Samples the field (trilinear interpolation).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	position	The position.
+			///
+			/// \return	The value of the field.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f sample(const Math::Vector3f & position) const
+			{
+				Math::Vector3f result ;
+				sample(&position, &result, 1) ;
+				return result ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void ForceFieldGrid::sample(const Math::Vector3f * positions, Math::Vector3f * results, size_t count) const
+			///
+			/// \brief	Samples the field at several positions. The loop has no branch and the corners are
+			/// 		interpolated 4 components at once (vectorized by the compiler).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	positions	 	The positions.
+			/// \param [out]	results	The values of the field.
+			/// \param	count		 	The number of positions.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void sample(const Math::Vector3f * positions, Math::Vector3f * results, size_t count) const
+			{
+				const float * values = m_values.data() ;
+				const size_t strideY = (size_t)m_resolution[0]*4 ;
+				const size_t strideZ = strideY*m_resolution[1] ;
+				for(size_t cpt=0 ; cpt<count ; ++cpt)
+				{
+					int cell[3] ;
+					float t[3] ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						float coordinate = ::std::min(::std::max((positions[cpt][axis]-m_min[axis])*m_inverseCellSize[axis], 0.0f), float(m_resolution[axis]-1)) ;
+						cell[axis] = ::std::min((int)coordinate, m_resolution[axis]-2) ;
+						t[axis] = coordinate-cell[axis] ;
+					}
+					const float * c000 = values+((size_t)cell[2]*m_resolution[1]+cell[1])*strideY+(size_t)cell[0]*4 ;
+					const float * c010 = c000+strideY ;
+					const float * c001 = c000+strideZ ;
+					const float * c011 = c001+strideY ;
+					float value[4] ;
+					for(int component=0 ; component<4 ; ++component)
+					{
+						float v00 = c000[component]+(c000[component+4]-c000[component])*t[0] ;
+						float v10 = c010[component]+(c010[component+4]-c010[component])*t[0] ;
+						float v01 = c001[component]+(c001[component+4]-c001[component])*t[0] ;
+						float v11 = c011[component]+(c011[component+4]-c011[component])*t[0] ;
+						float v0 = v00+(v10-v00)*t[1] ;
+						float v1 = v01+(v11-v01)*t[1] ;
+						value[component] = v0+(v1-v0)*t[2] ;
+					}
+					results[cpt] = Math::makeVector(value[0], value[1], value[2]) ;
+				}
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f ForceFieldGrid::operator() (const PonctualMass & mass) const
+			///
+			/// \brief	Force functor interface: samples the acceleration at the position of the mass and
+			/// 		scales it by the mass.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	mass	The mass.
+			///
+			/// \return	The force.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f operator() (const PonctualMass & mass) const
+			{
+				return sample(mass.m_position)*mass.m_mass ;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,393 @@
+#ifndef _Animation_IKLookupTable_H
+#define _Animation_IKLookupTable_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Math/UniformRandom.h>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	IKLookupTable
+	///
+	/// \brief	Precomputed samples of the workspace of an extremity, used to seed inverse kinematics.
+	/// 		The degrees of freedom of the path from the root to the extremity are sampled uniformly
+	/// 		in their limits and the positions of the extremity are stored in a uniform grid (samples
+	/// 		sorted by cell, about 4 samples per cell). At solve time, the pose of the sample nearest
+	/// 		to the target is used as initial guess: it can be copied in a pose of the compiled chain
+	/// 		(DampedLeastSquaresIK, Fabrik...) or written in the original chain
+	/// 		(JacobianInverseKinematics, CCD). Only the degrees of freedom of the path are modified.
+	/// 		The table can be saved to / loaded from a binary file to avoid the sampling at runtime.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class IKLookupTable
+	{
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The index of the extremity in the compiled chain.
+		int m_extremity ;
+		/// \brief	The offset from the extremity.
+		Math::Vector3f m_offset ;
+		/// \brief	The degrees of freedom of the path from the root to the extremity.
+		::std::vector<int> m_dofs ;
+		/// \brief	The positions of the extremity for each sample (sorted by cell).
+		::std::vector<Math::Vector3f> m_positions ;
+		/// \brief	The values of m_dofs for each sample (m_dofs.size() values per sample).
+		::std::vector<float> m_poses ;
+		/// \brief	The first sample of each cell (one more entry than cells).
+		::std::vector<::std::uint32_t> m_cellStart ;
+		/// \brief	The lower corner of the grid.
+		Math::Vector3f m_min ;
+		/// \brief	The size of the (cubic) cells.
+		float m_cellSize ;
+		/// \brief	The number of cells on each axis.
+		int m_resolution[3] ;
+
+		size_t cellIndex(int x, int y, int z) const
+		{
+			return ((size_t)z*m_resolution[1]+y)*m_resolution[0]+x ;
+		}
+
+		/// \brief	Cell coordinate of a position on an axis (clamped in the grid).
+		int cellCoordinate(const Math::Vector3f & position, int axis) const
+		{
+			int result = int(::std::floor((position[axis]-m_min[axis])/m_cellSize)) ;
+			return ::std::max(0, ::std::min(m_resolution[axis]-1, result)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void IKLookupTable::buildGrid()
+		///
+		/// \brief	Sorts the samples in the cells of a grid enclosing their positions.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void buildGrid()
+		{
+			const size_t samples = m_positions.size() ;
+			const size_t dofs = m_dofs.size() ;
+			Math::Vector3f max = m_positions[0] ;
+			m_min = m_positions[0] ;
+			for(size_t cpt=1 ; cpt<samples ; ++cpt)
+			{
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					m_min[axis] = ::std::min(m_min[axis], m_positions[cpt][axis]) ;
+					max[axis] = ::std::max(max[axis], m_positions[cpt][axis]) ;
+				}
+			}
+			Math::Vector3f extent = max-m_min ;
+			float largest = ::std::max(extent[0], ::std::max(extent[1], extent[2])) ;
+			float volume = ::std::max(extent[0], largest*1e-3f)*::std::max(extent[1], largest*1e-3f)*::std::max(extent[2], largest*1e-3f) ;
+			m_cellSize = (largest>0.0f) ? ::std::cbrt(volume*4.0f/float(samples)) : 1.0f ;
+			// At most 1024 cells per axis: the cells are enlarged (the cells must be cubes of side
+			// m_cellSize for the search in nearest to be exact)
+			for(int axis=0 ; axis<3 ; ++axis) { m_cellSize = ::std::max(m_cellSize, extent[axis]/1024.0f) ; }
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_resolution[axis] = ::std::max(1, ::std::min(1024, int(::std::ceil(extent[axis]/m_cellSize)))) ;
+			}
+			// Counting sort of the samples by cell
+			::std::vector<::std::uint32_t> cells(samples) ;
+			m_cellStart.assign(size_t(m_resolution[0])*m_resolution[1]*m_resolution[2]+1, 0) ;
+			for(size_t cpt=0 ; cpt<samples ; ++cpt)
+			{
+				const Math::Vector3f & position = m_positions[cpt] ;
+				cells[cpt] = ::std::uint32_t(cellIndex(cellCoordinate(position, 0), cellCoordinate(position, 1), cellCoordinate(position, 2))) ;
+				++m_cellStart[cells[cpt]+1] ;
+			}
+			for(size_t cell=1 ; cell<m_cellStart.size() ; ++cell) { m_cellStart[cell] += m_cellStart[cell-1] ; }
+			::std::vector<::std::uint32_t> next(m_cellStart.begin(), m_cellStart.end()-1) ;
+			::std::vector<Math::Vector3f> positions(samples) ;
+			::std::vector<float> poses(samples*dofs) ;
+			for(size_t cpt=0 ; cpt<samples ; ++cpt)
+			{
+				size_t destination = next[cells[cpt]]++ ;
+				positions[destination] = m_positions[cpt] ;
+				::std::copy(m_poses.begin()+cpt*dofs, m_poses.begin()+(cpt+1)*dofs, poses.begin()+destination*dofs) ;
+			}
+			m_positions.swap(positions) ;
+			m_poses.swap(poses) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	IKLookupTable::IKLookupTable(const CompiledKinematicChain & chain, int extremity,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Constructor. The table is empty, call build or load.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive this object).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	offset   	(optional) The offset from the extremity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		IKLookupTable(const CompiledKinematicChain & chain, int extremity, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+			: m_chain(&chain), m_extremity(extremity), m_offset(offset), m_min(Math::makeVector(0.0f, 0.0f, 0.0f)), m_cellSize(1.0f)
+		{
+			assert(extremity>=0 && size_t(extremity)<chain.nodes()) ;
+			for(int node=extremity ; node>=0 ; node=chain.father(node))
+			{
+				for(int dof=chain.firstDof(node)+chain.dofCount(node)-1 ; dof>=chain.firstDof(node) ; --dof) { m_dofs.push_back(dof) ; }
+			}
+			::std::reverse(m_dofs.begin(), m_dofs.end()) ;
+			m_resolution[0] = m_resolution[1] = m_resolution[2] = 0 ;
+		}
+
+		/// \brief	Number of samples.
+		size_t size() const
+		{
+			return m_positions.size() ;
+		}
+
+		/// \brief	The degrees of freedom stored for each sample (path from the root to the extremity).
+		const ::std::vector<int> & degreesOfFreedom() const
+		{
+			return m_dofs ;
+		}
+
+		/// \brief	Position of the extremity for a sample.
+		const Math::Vector3f & position(size_t sample) const
+		{
+			return m_positions[sample] ;
+		}
+
+		/// \brief	Values of degreesOfFreedom() for a sample.
+		const float * pose(size_t sample) const
+		{
+			return m_poses.data()+sample*m_dofs.size() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void IKLookupTable::build(size_t samples, const float * basePose, ::std::uint64_t seed = 0)
+		///
+		/// \brief	Samples the degrees of freedom of the path uniformly in their limits.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	samples 	The number of samples.
+		/// \param	basePose	The values of the other degrees of freedom (they do not influence the
+		/// 					extremity but the forward kinematics needs a complete pose).
+		/// \param	seed		(optional) The seed of the random generator.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build(size_t samples, const float * basePose, ::std::uint64_t seed = 0)
+		{
+			assert(samples>0) ;
+			const size_t dofs = m_dofs.size() ;
+			Math::UniformRandom random(seed) ;
+			CompiledKinematicChain::Workspace workspace(*m_chain) ;
+			::std::vector<float> values(basePose, basePose+m_chain->dofs()) ;
+			m_positions.resize(samples) ;
+			m_poses.resize(samples*dofs) ;
+			for(size_t sample=0 ; sample<samples ; ++sample)
+			{
+				float * pose = m_poses.data()+sample*dofs ;
+				for(size_t cpt=0 ; cpt<dofs ; ++cpt)
+				{
+					const Math::Interval<float> & limits = m_chain->limits(m_dofs[cpt]) ;
+					pose[cpt] = float(random(limits.inf(), limits.sup())) ;
+					values[m_dofs[cpt]] = pose[cpt] ;
+				}
+				m_chain->forwardKinematics(values.data(), workspace) ;
+				m_positions[sample] = m_chain->position(workspace, m_extremity, m_offset) ;
+			}
+			buildGrid() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t IKLookupTable::nearest(const Math::Vector3f & target) const
+		///
+		/// \brief	Finds the sample whose extremity is the nearest to a target. The cells are visited by
+		/// 		rings of increasing size around the cell of the target, until the rings are farther
+		/// 		than the nearest sample found.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	target	The target.
+		///
+		/// \return	The index of the nearest sample (the table must not be empty).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t nearest(const Math::Vector3f & target) const
+		{
+			assert(!m_positions.empty()) ;
+			int center[3] = { cellCoordinate(target, 0), cellCoordinate(target, 1), cellCoordinate(target, 2) } ;
+			int maxRing = ::std::max(m_resolution[0], ::std::max(m_resolution[1], m_resolution[2])) ;
+			size_t best = 0 ;
+			float bestDistance2 = ::std::numeric_limits<float>::max() ;
+			for(int ring=0 ; ring<maxRing ; ++ring)
+			{
+				int lower[3], upper[3] ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					lower[axis] = ::std::max(0, center[axis]-ring) ;
+					upper[axis] = ::std::min(m_resolution[axis]-1, center[axis]+ring) ;
+				}
+				for(int z=lower[2] ; z<=upper[2] ; ++z)
+				{
+					for(int y=lower[1] ; y<=upper[1] ; ++y)
+					{
+						bool shell = ::std::abs(z-center[2])==ring || ::std::abs(y-center[1])==ring ;
+						for(int x=lower[0] ; x<=upper[0] ; ++x)
+						{
+							// Inside the ring, only the cells at both ends of the row belong to the shell
+							if(!shell && ::std::abs(x-center[0])!=ring)
+							{
+								if(x<center[0]+ring) { x = center[0]+ring-1 ; }
+								continue ;
+							}
+							size_t cell = cellIndex(x, y, z) ;
+							for(::std::uint32_t sample=m_cellStart[cell] ; sample<m_cellStart[cell+1] ; ++sample)
+							{
+								float distance2 = (m_positions[sample]-target).norm2() ;
+								if(distance2<bestDistance2)
+								{
+									bestDistance2 = distance2 ;
+									best = sample ;
+								}
+							}
+						}
+					}
+				}
+				// The samples of the next rings are at least at ring*m_cellSize from the target
+				float bound = float(ring)*m_cellSize ;
+				if(bestDistance2<=bound*bound) { break ; }
+			}
+			return best ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void IKLookupTable::seed(float * pose, const Math::Vector3f & target) const
+		///
+		/// \brief	Writes the values of the sample nearest to target in a pose of the compiled chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose  	The pose (only the degrees of freedom of the path are modified).
+		/// \param 		 	target	The target.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void seed(float * pose, const Math::Vector3f & target) const
+		{
+			const float * values = this->pose(nearest(target)) ;
+			for(size_t cpt=0 ; cpt<m_dofs.size() ; ++cpt) { pose[m_dofs[cpt]] = values[cpt] ; }
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void IKLookupTable::seed(CompiledKinematicChain & chain, const Math::Vector3f & target) const
+		///
+		/// \brief	Writes the values of the sample nearest to target in the original chain (to seed the
+		/// 		solvers working on KinematicChain such as JacobianInverseKinematics or CCD).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	chain 	The compiled chain of the table.
+		/// \param 		 	target	The target.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void seed(CompiledKinematicChain & chain, const Math::Vector3f & target) const
+		{
+			assert(&chain==m_chain) ;
+			const float * values = this->pose(nearest(target)) ;
+			for(size_t cpt=0 ; cpt<m_dofs.size() ; ++cpt) { chain.writeDegreeOfFreedom(m_dofs[cpt], values[cpt]) ; }
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool IKLookupTable::save(const ::std::string & fileName) const
+		///
+		/// \brief	Saves the table in a binary file (native endianness).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	fileName	Filename of the file.
+		///
+		/// \return	true if the file has been written.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool save(const ::std::string & fileName) const
+		{
+			::std::ofstream output(fileName, ::std::ios::binary) ;
+			if(!output) { return false ; }
+			::std::uint32_t header[8] = { 0x544c4b49u /* IKLT */, 1u, ::std::uint32_t(m_chain->nodes()), ::std::uint32_t(m_chain->dofs()),
+										  ::std::uint32_t(m_extremity), ::std::uint32_t(m_dofs.size()), ::std::uint32_t(m_positions.size()), 0u } ;
+			float grid[7] = { m_offset[0], m_offset[1], m_offset[2], m_min[0], m_min[1], m_min[2], m_cellSize } ;
+			output.write((const char*)header, sizeof(header)) ;
+			output.write((const char*)grid, sizeof(grid)) ;
+			output.write((const char*)m_resolution, sizeof(m_resolution)) ;
+			output.write((const char*)m_dofs.data(), m_dofs.size()*sizeof(int)) ;
+			output.write((const char*)m_cellStart.data(), m_cellStart.size()*sizeof(::std::uint32_t)) ;
+			output.write((const char*)m_positions.data(), m_positions.size()*sizeof(Math::Vector3f)) ;
+			output.write((const char*)m_poses.data(), m_poses.size()*sizeof(float)) ;
+			return bool(output) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool IKLookupTable::load(const ::std::string & fileName)
+		///
+		/// \brief	Loads a table saved by save. The file must have been computed for the same chain,
+		/// 		extremity and offset, otherwise the table is left unchanged.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	fileName	Filename of the file.
+		///
+		/// \return	true if the table has been loaded.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool load(const ::std::string & fileName)
+		{
+			::std::ifstream input(fileName, ::std::ios::binary) ;
+			if(!input) { return false ; }
+			::std::uint32_t header[8] ;
+			float grid[7] ;
+			int resolution[3] ;
+			input.read((char*)header, sizeof(header)) ;
+			input.read((char*)grid, sizeof(grid)) ;
+			input.read((char*)resolution, sizeof(resolution)) ;
+			if(!input || header[0]!=0x544c4b49u || header[1]!=1u || header[2]!=m_chain->nodes() || header[3]!=m_chain->dofs() ||
+			   header[4]!=::std::uint32_t(m_extremity) || header[5]!=m_dofs.size() || header[6]==0 ||
+			   grid[0]!=m_offset[0] || grid[1]!=m_offset[1] || grid[2]!=m_offset[2] ||
+			   !(grid[6]>0.0f) || resolution[0]<1 || resolution[1]<1 || resolution[2]<1 ||
+			   resolution[0]>1024 || resolution[1]>1024 || resolution[2]>1024)
+			{
+				return false ;
+			}
+			::std::vector<int> dofs(m_dofs.size()) ;
+			::std::vector<::std::uint32_t> cellStart(size_t(resolution[0])*resolution[1]*resolution[2]+1) ;
+			::std::vector<Math::Vector3f> positions(header[6]) ;
+			::std::vector<float> poses(size_t(header[6])*m_dofs.size()) ;
+			input.read((char*)dofs.data(), dofs.size()*sizeof(int)) ;
+			input.read((char*)cellStart.data(), cellStart.size()*sizeof(::std::uint32_t)) ;
+			input.read((char*)positions.data(), positions.size()*sizeof(Math::Vector3f)) ;
+			input.read((char*)poses.data(), poses.size()*sizeof(float)) ;
+			if(!input || dofs!=m_dofs || cellStart.front()!=0 || cellStart.back()!=header[6]) { return false ; }
+			// The samples of the cells must be consecutive ranges
+			for(size_t cell=1 ; cell<cellStart.size() ; ++cell)
+			{
+				if(cellStart[cell]<cellStart[cell-1]) { return false ; }
+			}
+			m_min = Math::makeVector(grid[3], grid[4], grid[5]) ;
+			m_cellSize = grid[6] ;
+			::std::copy(resolution, resolution+3, m_resolution) ;
+			m_cellStart.swap(cellStart) ;
+			m_positions.swap(positions) ;
+			m_poses.swap(poses) ;
+			return true ;
+		}
+	};
+}
+
+#endif
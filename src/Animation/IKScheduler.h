@@ -0,0 +1,299 @@
+#ifndef _Animation_IKScheduler_H
+#define _Animation_IKScheduler_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Animation/DampedLeastSquaresIK.h>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	IKScheduler
+	///
+	/// \brief	Distributes a time budget per frame between inverse kinematics tasks. Each task owns a
+	/// 		solver, a pose and a target. update(budget) runs slices of a few iterations, always on
+	/// 		the running task with the highest urgency (priority x residual x (1 + number of frames
+	/// 		without slice)), until the budget is spent: the duration of the next slice is estimated
+	/// 		by the average duration of the previous ones. Tasks which are not finished resume at the
+	/// 		next frame, the state of the solver (pose, damping...) being kept. A task is finished
+	/// 		when it converges, stalls, or reaches the maximum number of iterations for its target.
+	/// 		At least one slice is run per frame to guarantee progress.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \tparam	Solver	The solver (DampedLeastSquaresIK or Fabrik), built from (chain, extremity, offset)
+	/// 				and providing Result solve(float * pose, const Math::Vector3f & target,
+	/// 				unsigned int maxIterations, float tolerance).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <class Solver = DampedLeastSquaresIK>
+	class IKScheduler
+	{
+	public:
+		typedef DampedLeastSquaresIK::Result Result ;
+
+		/// \brief	Status of a task.
+		enum Status { idle, running, converged, failed } ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Task
+		///
+		/// \brief	An inverse kinematics task.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Task
+		{
+		public:
+			/// \brief	The solver.
+			Solver m_solver ;
+			/// \brief	The pose (owned by the caller, one per task).
+			float * m_pose ;
+			/// \brief	The target.
+			Math::Vector3f m_target ;
+			/// \brief	The priority (strictly positive).
+			float m_priority ;
+			/// \brief	The status.
+			Status m_status ;
+			/// \brief	The residual after the last slice (negative if not yet evaluated).
+			float m_residual ;
+			/// \brief	The number of iterations since the target has been set.
+			unsigned int m_iterations ;
+			/// \brief	The number of frames without slice while running.
+			unsigned int m_waitingFrames ;
+
+			Task(const CompiledKinematicChain & chain, int extremity, float * pose, const Math::Vector3f & offset, float priority)
+				: m_solver(chain, extremity, offset), m_pose(pose), m_target(Math::makeVector(0.0f, 0.0f, 0.0f)), m_priority(priority),
+				  m_status(idle), m_residual(-1.0f), m_iterations(0), m_waitingFrames(0)
+			{}
+
+			/// \brief	The urgency of the task used to choose the next slice.
+			float urgency() const
+			{
+				return m_priority*m_residual*float(1+m_waitingFrames) ;
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	FrameStatistics
+		///
+		/// \brief	What has been done by a call to update.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class FrameStatistics
+		{
+		public:
+			/// \brief	The number of slices.
+			unsigned int m_slices ;
+			/// \brief	The number of iterations.
+			unsigned int m_iterations ;
+			/// \brief	The number of tasks finished during the frame.
+			unsigned int m_finished ;
+			/// \brief	The number of tasks still running after the frame.
+			unsigned int m_pending ;
+			/// \brief	The time spent in update (microseconds).
+			double m_microseconds ;
+
+			FrameStatistics()
+				: m_slices(0), m_iterations(0), m_finished(0), m_pending(0), m_microseconds(0.0)
+			{}
+		};
+
+	protected:
+		typedef ::std::chrono::steady_clock Clock ;
+
+		/// \brief	The tasks.
+		::std::vector<Task> m_tasks ;
+		/// \brief	The tolerance on the distance to the target.
+		float m_tolerance ;
+		/// \brief	The maximum number of iterations per target.
+		unsigned int m_maxIterations ;
+		/// \brief	The number of iterations of a slice.
+		unsigned int m_sliceIterations ;
+		/// \brief	The average duration of a slice (microseconds).
+		double m_sliceMicroseconds ;
+		/// \brief	Heap of the urgencies / indexes of the running tasks (reused between frames).
+		::std::vector<::std::pair<float, size_t> > m_queue ;
+		/// \brief	Flags of the tasks served during the frame (reused between frames).
+		::std::vector<bool> m_served ;
+
+		static double microseconds(Clock::time_point start)
+		{
+			return ::std::chrono::duration<double, ::std::micro>(Clock::now()-start).count() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	unsigned int IKScheduler::runSlice(Task & task, unsigned int iterations)
+		///
+		/// \brief	Runs at most iterations iterations on a task and updates its status.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The number of iterations done.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		unsigned int runSlice(Task & task, unsigned int iterations)
+		{
+			iterations = ::std::min(iterations, m_maxIterations-task.m_iterations) ;
+			Result result = task.m_solver.solve(task.m_pose, task.m_target, iterations, m_tolerance) ;
+			task.m_iterations += result.m_iterations ;
+			task.m_residual = result.m_residual ;
+			if(result.m_converged) { task.m_status = converged ; }
+			// The solver stops before the end of the slice when it is stuck
+			else if(result.m_iterations<iterations || task.m_iterations>=m_maxIterations) { task.m_status = failed ; }
+			return result.m_iterations ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	IKScheduler::IKScheduler(float tolerance = 0.001f, unsigned int maxIterations = 100,
+		/// 	unsigned int sliceIterations = 2)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	tolerance	   	(optional) The tolerance on the distance to the target.
+		/// \param	maxIterations  	(optional) The maximum number of iterations per target.
+		/// \param	sliceIterations	(optional) The number of iterations of a slice.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		IKScheduler(float tolerance = 0.001f, unsigned int maxIterations = 100, unsigned int sliceIterations = 2)
+			: m_tolerance(tolerance), m_maxIterations(maxIterations), m_sliceIterations(::std::max(1u, sliceIterations)), m_sliceMicroseconds(0.0)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t IKScheduler::addTask(const CompiledKinematicChain & chain, int extremity, float * pose,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), float priority = 1.0f)
+		///
+		/// \brief	Adds a task (idle until a target is set).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive the scheduler).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	pose	 	The pose (chain.dofs() values, must outlive the scheduler).
+		/// \param	offset   	(optional) The offset from the extremity.
+		/// \param	priority 	(optional) The priority.
+		///
+		/// \return	The index of the task.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t addTask(const CompiledKinematicChain & chain, int extremity, float * pose, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), float priority = 1.0f)
+		{
+			assert(priority>0.0f) ;
+			m_tasks.push_back(Task(chain, extremity, pose, offset, priority)) ;
+			// The frame buffers are allocated here, not during update
+			m_queue.reserve(m_tasks.size()) ;
+			m_served.reserve(m_tasks.size()) ;
+			return m_tasks.size()-1 ;
+		}
+
+		/// \brief	Sets the target of a task, the task is running until it is finished.
+		void setTarget(size_t task, const Math::Vector3f & target)
+		{
+			Task & current = m_tasks[task] ;
+			current.m_target = target ;
+			current.m_status = running ;
+			current.m_residual = -1.0f ;
+			current.m_iterations = 0 ;
+		}
+
+		void setPriority(size_t task, float priority)
+		{
+			assert(priority>0.0f) ;
+			m_tasks[task].m_priority = priority ;
+		}
+
+		const Task & task(size_t task) const
+		{
+			return m_tasks[task] ;
+		}
+
+		size_t size() const
+		{
+			return m_tasks.size() ;
+		}
+
+		/// \brief	Is there a running task?
+		bool pending() const
+		{
+			for(auto it=m_tasks.begin(), end=m_tasks.end() ; it!=end ; ++it)
+			{
+				if(it->m_status==running) { return true ; }
+			}
+			return false ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	FrameStatistics IKScheduler::update(double budget)
+		///
+		/// \brief	Runs the tasks during at most budget microseconds (except the first slice).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	budget	The time budget of the frame in microseconds.
+		///
+		/// \return	The statistics of the frame.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		FrameStatistics update(double budget)
+		{
+			Clock::time_point start = Clock::now() ;
+			FrameStatistics statistics ;
+			// Urgency / index of the running tasks (max heap)
+			::std::vector<::std::pair<float, size_t> > & queue = m_queue ;
+			queue.clear() ;
+			for(size_t cpt=0 ; cpt<m_tasks.size() ; ++cpt)
+			{
+				Task & task = m_tasks[cpt] ;
+				if(task.m_status!=running) { continue ; }
+				// New target: the residual is evaluated without iteration
+				if(task.m_residual<0.0f) { runSlice(task, 0) ; }
+				if(task.m_status==running) { queue.push_back(::std::make_pair(task.urgency(), cpt)) ; }
+				else { ++statistics.m_finished ; }
+			}
+			::std::make_heap(queue.begin(), queue.end()) ;
+			::std::vector<bool> & served = m_served ;
+			served.assign(m_tasks.size(), false) ;
+			while(!queue.empty() && (statistics.m_slices==0 || microseconds(start)+m_sliceMicroseconds<=budget))
+			{
+				::std::pop_heap(queue.begin(), queue.end()) ;
+				Task & task = m_tasks[queue.back().second] ;
+				served[queue.back().second] = true ;
+				queue.pop_back() ;
+				Clock::time_point sliceStart = Clock::now() ;
+				unsigned int iterations = runSlice(task, m_sliceIterations) ;
+				double duration = microseconds(sliceStart) ;
+				// Exponential average of the duration of the slices
+				m_sliceMicroseconds = (m_sliceMicroseconds==0.0) ? duration : m_sliceMicroseconds*0.9+duration*0.1 ;
+				++statistics.m_slices ;
+				statistics.m_iterations += iterations ;
+				task.m_waitingFrames = 0 ;
+				if(task.m_status==running)
+				{
+					queue.push_back(::std::make_pair(task.urgency(), size_t(&task-m_tasks.data()))) ;
+					::std::push_heap(queue.begin(), queue.end()) ;
+				}
+				else { ++statistics.m_finished ; }
+			}
+			for(size_t cpt=0 ; cpt<m_tasks.size() ; ++cpt)
+			{
+				Task & task = m_tasks[cpt] ;
+				if(task.m_status!=running) { continue ; }
+				++statistics.m_pending ;
+				if(!served[cpt]) { ++task.m_waitingFrames ; }
+			}
+			statistics.m_microseconds = microseconds(start) ;
+			return statistics ;
+		}
+	};
+}
+
+#endif
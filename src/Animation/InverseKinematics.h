@@ -45,7 +45,7 @@ namespace Animation
 				KinematicChain::DegreeOfFreedom & dof = *it ;
 				Math::Vector3f extremity = m_node->getGlobalTransformation()*offset ;
 				Math::Vector3f deltaTarget = target-extremity ;
-				Math::Vector3f derivate = m_chain->derivate(m_node, offset, dof, 0.01f) ;
+				Math::Vector3f derivate = m_chain->derivate(m_node, offset, dof) ;
 				float deltaAngle = ::Math::Interval<float>(-maxDeltaAngle, maxDeltaAngle).clamp(derivate.inv()*deltaTarget) ;
 				if(Math::is_valid(deltaAngle))
 				{
@@ -71,7 +71,7 @@ namespace Animation
 		/// \param	extremity	The extremity on which inverse kimatics will be computed.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		InverseKinematics(KinematicChain * chain, KinematicChain::Node * extremity)
-			: m_node(extremity)
+			: m_chain(chain), m_node(extremity)
 		{
 			extremity->collectDegreesOfFreedom(m_degreesOfFreedom) ;
 		}
@@ -84,7 +84,7 @@ namespace Animation
 			::std::transform(m_degreesOfFreedom.begin(), m_degreesOfFreedom.end(), result.begin(),
 			    [&](KinematicChain::DegreeOfFreedom & dof) -> float
 				{
-					Math::Vector3f result = m_chain->derivate(m_node, offset, dof, 0.01f) ;
+					Math::Vector3f result = m_chain->derivate(m_node, offset, dof) ;
 					float retValue = result.inv()*delta;
 					if(!Math::is_valid(retValue)) { return 0.0 ; }
 					return retValue ;
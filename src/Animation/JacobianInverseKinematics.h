@@ -32,13 +32,15 @@ namespace Animation
 		KinematicChain::Node * m_node;
 		/// \brief	The degrees of freedom of the kinematic chain.
 		::std::vector<KinematicChain::DegreeOfFreedom> m_degreesOfFreedom;
+		/// \brief	The columns of the last computed jacobian.
+		::std::vector<Math::Vector3f> m_jacobianColumns ;
 
 	protected:
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	Math::Matrix<JacobianScalar> JacobianInverseKinematics::computeJacobian(Math::Vector3f const & offset)
 		///
-		/// \brief	Calculates the jacobian matrix.
+		/// \brief	Calculates the jacobian matrix (analytic derivatives, one sweep of the chain).
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	05/04/2016
@@ -50,12 +52,12 @@ namespace Animation
 		Math::Matrix<JacobianScalar> computeJacobian(Math::Vector3f const & offset)
 		{
 			Math::Matrix<JacobianScalar> result(3, m_degreesOfFreedom.size()) ;
+			m_chain->computeJacobian(m_node, offset, m_degreesOfFreedom, m_jacobianColumns) ;
 			for(unsigned int cpt=0 ; cpt<m_degreesOfFreedom.size() ; ++cpt)
 			{
-				Math::Vector3f derivate = m_chain->derivate(m_node, offset, m_degreesOfFreedom[cpt], 0.01f) ;
 				for(int row=0 ; row<3 ; ++row)
 				{
-					result(row, cpt) = derivate[row] ;
+					result(row, cpt) = m_jacobianColumns[cpt][row] ;
 				}
 			}
 			return result ;
@@ -82,6 +84,26 @@ namespace Animation
 			return result ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Matrix<JacobianScalar> JacobianInverseKinematics::angleCostGradient()
+		///
+		/// \brief	Analytic gradient of angleCostFunction: -2.(middle-angle) for each degree of freedom.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The gradient (column vector).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Matrix<JacobianScalar> angleCostGradient()
+		{
+			Math::Matrix<JacobianScalar> result(m_degreesOfFreedom.size(), 1) ;
+			for(unsigned int cpt=0 ; cpt<m_degreesOfFreedom.size() ; ++cpt)
+			{
+				result(cpt,0) = -2.0*(m_degreesOfFreedom[cpt].constraint().middle()-m_degreesOfFreedom[cpt]) ;
+			}
+			return result ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	template <class Function> float JacobianInverseKinematics::derivateCostFunction(const Function & function,
 		/// 	KinematicChain::DegreeOfFreedom & dof, float epsilon)
@@ -150,7 +172,7 @@ namespace Animation
 		/// \param	extremity	The extremity on which inverse kimatics will be computed.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		JacobianInverseKinematics(KinematicChain * chain, KinematicChain::Node * extremity)
-			: m_node(extremity)
+			: m_chain(chain), m_node(extremity)
 		{
 			extremity->collectDegreesOfFreedom(m_degreesOfFreedom) ;
 		}
@@ -234,7 +256,7 @@ namespace Animation
 				Math::Matrix<JacobianScalar> dx = target-m_node->getGlobalTransformation()*offset ;
 				Math::Matrix<JacobianScalar> pseudoInverse = jacobian.pseudoInverse() ;
 				Math::Matrix<JacobianScalar> kernel = Math::Matrix<JacobianScalar>::identity(m_degreesOfFreedom.size(), m_degreesOfFreedom.size())-pseudoInverse*jacobian ;
-				Math::Matrix<JacobianScalar> dz = derivateCostFunction([this]() -> float { return angleCostFunction() ; }, 0.001f)*-1.0 ;
+				Math::Matrix<JacobianScalar> dz = angleCostGradient()*-1.0 ;
 				Math::Matrix<JacobianScalar> dTheta = pseudoInverse*dx + (kernel*(dz))*0.01 ;
 				
 				//JacobianScalar max = ::std::max(fabs(dTheta.maxValue()), fabs(dTheta.minValue())) ;
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 namespace Animation
 {
@@ -27,6 +28,9 @@ namespace Animation
 		class StaticNode ;
 		class DynamicNode ;
 
+		/// \brief	Type of the joint associated with a node.
+		enum JointType { staticJoint, rotationJoint, eulerRotationJoint, translationJoint } ;
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \class	DegreeOfFreedom
 		///
@@ -106,11 +110,35 @@ namespace Animation
 				return m_node ;
 			}
 
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	size_t DegreeOfFreedom::index() const
+			///
+			/// \brief	Gets the index of this degree of freedom in the degrees of freedom of its node.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			size_t index() const ;
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	bool DegreeOfFreedom::operator== (const DegreeOfFreedom & other) const
+			///
+			/// \brief	Tests if two objects manipulate the same degree of freedom.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			bool operator== (const DegreeOfFreedom & other) const
+			{
+				return m_value==other.m_value ;
+			}
+
 			////////////////////////////////////////////////////////////////////////////////////////////////////
 			/// \fn	DegreeOfFreedom & DegreeOfFreedom::operator= (float value);
 			///
 			/// \brief	Assignment operator. This operator ensures the constraints i.e. if the value is outside
-			/// 		the authorized interval, it is rounded to the nearest valid value.
+			/// 		the authorized interval, it is rounded to the nearest valid value. The cached global
+			/// 		transformations of the node and of its descendants are invalidated.
 			///
 			/// \author	F. Lamarche, Universit de Rennes 1
 			/// \date	12/02/2016
@@ -123,6 +151,7 @@ namespace Animation
 			{
 				(*m_value) = value ;
 				m_node->update() ;
+				m_node->invalidate() ;
 				return *this ;
 			}
 		};
@@ -150,6 +179,11 @@ namespace Animation
 			::std::vector<DegreeOfFreedom> m_degreesOfFreedom ;
 			/// \brief	The transformation associated with this node.
 			Math::Matrix4x4f m_transformation ;
+			/// \brief	Cache of the global transformation (valid if m_globalTransformationValid is true).
+			mutable Math::Matrix4x4f m_globalTransformation ;
+			/// \brief	true if the cached global transformation is up to date. If a node is invalid, all
+			/// 		its descendants are invalid.
+			mutable bool m_globalTransformationValid ;
 
 			////////////////////////////////////////////////////////////////////////////////////////////////////
 			/// \fn	void Node::addSon(Node * son)
@@ -182,7 +216,7 @@ namespace Animation
 			/// \param	matrix	(optional) the transformation matrix associated with this node.
 			////////////////////////////////////////////////////////////////////////////////////////////////////
 			Node(Node * father = NULL, const Math::Matrix4x4f & matrix = Math::Matrix4x4f::getIdentity())
-				: m_father(father), m_transformation(matrix)
+				: m_father(father), m_transformation(matrix), m_globalTransformationValid(false)
 			{
 				if(m_father!=NULL)
 				{
@@ -206,25 +240,61 @@ namespace Animation
 			}
 
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			/// \fn	Math::Matrix4x4f Node::getGlobalTransformation() const
+			/// \fn	Node * Node::getFather() const
 			///
-			/// \brief	Gets the global transformation leading from the root to this node.
+			/// \brief	Gets the father node.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \return	The father node, NULL for the root.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Node * getFather() const
+			{
+				return m_father ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	const Math::Matrix4x4f & Node::getGlobalTransformation() const
+			///
+			/// \brief	Gets the global transformation leading from the root to this node. The result is
+			/// 		cached: only the invalid ancestors of this node are recomputed. As the cache is
+			/// 		updated, concurrent calls on the same chain are not allowed.
 			///
 			/// \author	F. Lamarche, Universit de Rennes 1
 			/// \date	12/02/2016
 			///
 			/// \return	The global transformation.
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			Math::Matrix4x4f getGlobalTransformation() const
+			const Math::Matrix4x4f & getGlobalTransformation() const
+			{
+				if(!m_globalTransformationValid)
+				{
+					if(m_father!=NULL) { m_globalTransformation = m_father->getGlobalTransformation() * m_transformation ; }
+					else { m_globalTransformation = m_transformation ; }
+					m_globalTransformationValid = true ;
+				}
+				return m_globalTransformation ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void Node::invalidate()
+			///
+			/// \brief	Invalidates the cached global transformation of this node and of its descendants.
+			/// 		This function is called when a degree of freedom is modified. The propagation stops on
+			/// 		invalid nodes whose descendants are already invalid.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void invalidate()
 			{
-				Math::Matrix4x4f result = m_transformation ;
-				Node * father = m_father ;
-				while(father!=NULL)
+				if(!m_globalTransformationValid) { return ; }
+				m_globalTransformationValid = false ;
+				for(auto it=m_sons.begin(), end=m_sons.end() ; it!=end ; ++it)
 				{
-					result = father->m_transformation * result ;
-					father = father->m_father ;
+					(*it)->invalidate() ;
 				}
-				return result ;
 			}
 
 			////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -288,6 +358,54 @@ namespace Animation
 			virtual void update()
 			{}
 
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	virtual Math::Vector3f Node::derivateLocal(size_t dofIndex, const Math::Vector3f & point) const
+			///
+			/// \brief	Analytic derivative of the local transformation with respect to a degree of freedom of
+			/// 		this node, applied on a point expressed in the frame of this node. The result is a
+			/// 		direction expressed in the frame of the father.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	dofIndex	Index of the degree of freedom in getDOF().
+			/// \param	point   	The point.
+			///
+			/// \return	The derivative of getLocalTransformation()*point.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			virtual Math::Vector3f derivateLocal(size_t /*dofIndex*/, const Math::Vector3f & /*point*/) const
+			{
+				assert(false && "Node without degree of freedom") ;
+				return Math::makeVector(0.0f, 0.0f, 0.0f) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	virtual JointType Node::getJointType() const
+			///
+			/// \brief	Gets the type of the joint. The local transformation of a static joint is constant.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			virtual JointType getJointType() const
+			{
+				return staticJoint ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	virtual Math::Vector3f Node::getJointAxis() const
+			///
+			/// \brief	Gets the normalized axis of a rotation joint or the normalized direction of a
+			/// 		translation joint (null vector for the other joints).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			virtual Math::Vector3f getJointAxis() const
+			{
+				return Math::makeVector(0.0f, 0.0f, 0.0f) ;
+			}
+
 			virtual ~Node()
 			{}
 		};
@@ -435,6 +553,22 @@ namespace Animation
 				m_angleZ = m_ctrZ.clamp(m_angleZ) ;
 				m_transformation = Math::Matrix4x4f::getRotationX(m_angleX)*Math::Matrix4x4f::getRotationY(m_angleY)*Math::Matrix4x4f::getRotationZ(m_angleZ) ;
 			}
+
+			/// \brief	d(Rx.Ry.Rz.p) is X^(Rx.Ry.Rz.p), Rx.(Y^(Ry.Rz.p)) or Rx.Ry.(Z^(Rz.p)).
+			virtual Math::Vector3f derivateLocal(size_t dofIndex, const Math::Vector3f & point) const
+			{
+				assert(dofIndex<3) ;
+				if(dofIndex==0) { return Math::makeVector(1.0f, 0.0f, 0.0f)^(m_transformation*point) ; }
+				Math::Vector3f rotatedZ = Math::Matrix4x4f::getRotationZ(m_angleZ)*point ;
+				Math::Matrix4x4f rotationX = Math::Matrix4x4f::getRotationX(m_angleX) ;
+				if(dofIndex==1) { return rotationX*(Math::makeVector(0.0f, 1.0f, 0.0f)^(Math::Matrix4x4f::getRotationY(m_angleY)*rotatedZ)) ; }
+				return rotationX*(Math::Matrix4x4f::getRotationY(m_angleY)*(Math::makeVector(0.0f, 0.0f, 1.0f)^rotatedZ)) ;
+			}
+
+			virtual JointType getJointType() const
+			{
+				return eulerRotationJoint ;
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -466,6 +600,24 @@ namespace Animation
 				m_angle = m_ctrAngle.clamp(m_angle) ;
 				m_transformation = Math::Matrix4x4f::getRotation(m_axis, m_angle) ;
 			}
+
+			/// \brief	d(R.p) is axis^(R.p).
+			virtual Math::Vector3f derivateLocal(size_t dofIndex, const Math::Vector3f & point) const
+			{
+				assert(dofIndex==0) ;
+				(void)dofIndex ;
+				return m_axis.normalized()^(m_transformation*point) ;
+			}
+
+			virtual JointType getJointType() const
+			{
+				return rotationJoint ;
+			}
+
+			virtual Math::Vector3f getJointAxis() const
+			{
+				return m_axis.normalized() ;
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -497,6 +649,24 @@ namespace Animation
 				m_norm = m_ctrNorm.clamp(m_norm) ;
 				m_transformation = Math::Matrix4x4f::getTranslation(m_normalizedVector*m_norm) ;
 			}
+
+			/// \brief	d(p+v.norm) is v.
+			virtual Math::Vector3f derivateLocal(size_t dofIndex, const Math::Vector3f & /*point*/) const
+			{
+				assert(dofIndex==0) ;
+				(void)dofIndex ;
+				return m_normalizedVector ;
+			}
+
+			virtual JointType getJointType() const
+			{
+				return translationJoint ;
+			}
+
+			virtual Math::Vector3f getJointAxis() const
+			{
+				return m_normalizedVector ;
+			}
 		};
 
 	protected:
@@ -518,6 +688,13 @@ namespace Animation
 			destroySons(&m_root) ;
 		}
 
+		/// \brief	Applies the linear part of a transformation on a direction.
+		static Math::Vector3f transformDirection(const Math::Matrix4x4f & transformation, const Math::Vector3f & direction)
+		{
+			Math::Vector4f result = transformation*Math::makeVector(direction[0], direction[1], direction[2], 0.0f) ;
+			return Math::makeVector(result[0], result[1], result[2]) ;
+		}
+
 	public:
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -693,6 +870,81 @@ namespace Animation
 			return (transformPlus-transformMinus)/(realEpsilon) ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3f KinematicChain::derivate(Node * extremity, const Math::Vector3f & offset,
+		/// 	const DegreeOfFreedom & dof) const
+		///
+		/// \brief	Analytic derivative of the position of the extremity of the chain with offset offset. The
+		/// 		derivative is null if the degree of freedom does not belong to an ancestor of extremity.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param extremity	The extremity.
+		/// \param offset		The offset.
+		/// \param dof		 	The degree of freedom.
+		///
+		/// \return	The derivate.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3f derivate(Node * extremity, const Math::Vector3f & offset, const DegreeOfFreedom & dof) const
+		{
+			// Point in the frame of the node providing the degree of freedom
+			Math::Vector3f point = offset ;
+			const Node * node = extremity ;
+			while(node!=NULL && node!=dof.node())
+			{
+				point = node->getLocalTransformation()*point ;
+				node = node->getFather() ;
+			}
+			if(node==NULL) { return Math::makeVector(0.0f, 0.0f, 0.0f) ; }
+			Math::Vector3f result = node->derivateLocal(dof.index(), point) ;
+			if(node->getFather()==NULL) { return result ; }
+			return transformDirection(node->getFather()->getGlobalTransformation(), result) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void KinematicChain::computeJacobian(Node * extremity, const Math::Vector3f & offset,
+		/// 	const ::std::vector<DegreeOfFreedom> & dofs, ::std::vector<Math::Vector3f> & columns) const
+		///
+		/// \brief	Computes the analytic jacobian of the position of the extremity of the chain with offset
+		/// 		offset in one sweep from the extremity to the root. columns[i] receives the derivative with
+		/// 		respect to dofs[i] (null if dofs[i] does not belong to an ancestor of extremity). The
+		/// 		matching is linear when dofs is ordered from the root to the extremity, as provided by
+		/// 		Node::collectDegreesOfFreedom.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	extremity	The extremity.
+		/// \param 		 	offset   	The offset.
+		/// \param 		 	dofs	 	The degrees of freedom.
+		/// \param [in,out]	columns  	The columns of the jacobian.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeJacobian(Node * extremity, const Math::Vector3f & offset, const ::std::vector<DegreeOfFreedom> & dofs, ::std::vector<Math::Vector3f> & columns) const
+		{
+			columns.assign(dofs.size(), Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+			// Updates the cached global transformations of all the ancestors
+			extremity->getGlobalTransformation() ;
+			size_t next = dofs.size() ;
+			Math::Vector3f point = offset ;
+			for(const Node * node = extremity ; node!=NULL ; node = node->getFather())
+			{
+				const ::std::vector<DegreeOfFreedom> & nodeDofs = node->getDOF() ;
+				for(size_t index=nodeDofs.size() ; index>0 ; --index)
+				{
+					const DegreeOfFreedom & dof = nodeDofs[index-1] ;
+					size_t column = dofs.size() ;
+					if(next>0 && dofs[next-1]==dof) { column = next-1 ; }
+					else { column = ::std::find(dofs.begin(), dofs.end(), dof)-dofs.begin() ; }
+					if(column==dofs.size()) { continue ; }
+					next = column ;
+					Math::Vector3f derivative = node->derivateLocal(index-1, point) ;
+					columns[column] = (node->getFather()==NULL) ? derivative : transformDirection(node->getFather()->getGlobalTransformation(), derivative) ;
+				}
+				point = node->getLocalTransformation()*point ;
+			}
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	KinematicChain::~KinematicChain()
 		///
@@ -707,6 +959,14 @@ namespace Animation
 		}
 	};
 
+	inline size_t KinematicChain::DegreeOfFreedom::index() const
+	{
+		const ::std::vector<DegreeOfFreedom> & dofs = m_node->getDOF() ;
+		size_t result = ::std::find(dofs.begin(), dofs.end(), *this)-dofs.begin() ;
+		assert(result<dofs.size()) ;
+		return result ;
+	}
+
 }
 
 #endif
\ No newline at end of file
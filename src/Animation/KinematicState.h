@@ -0,0 +1,188 @@
+#ifndef _Animation_KinematicState_H
+#define _Animation_KinematicState_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <vector>
+#include <algorithm>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	KinematicState
+	///
+	/// \brief	A pose of a compiled chain with its forward kinematics. The state is a value: it can be
+	/// 		copied and modified without affecting the original KinematicChain nor the other copies
+	/// 		(the topology is shared and read only), which allows evaluating many poses concurrently.
+	/// 		The forward kinematics is incremental: modifying a degree of freedom only invalidates the
+	/// 		nodes stored after its node, update() recomputes them.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class KinematicState
+	{
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The values of the degrees of freedom.
+		::std::vector<float> m_pose ;
+		/// \brief	The transformations of the nodes.
+		CompiledKinematicChain::Workspace m_workspace ;
+		/// \brief	The first node whose transformations are not up to date (nodes() if up to date).
+		int m_firstDirty ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	KinematicState::KinematicState(const CompiledKinematicChain & chain)
+		///
+		/// \brief	Constructor. The pose is read from the original chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	The compiled chain (must outlive this object).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		KinematicState(const CompiledKinematicChain & chain)
+			: m_chain(&chain), m_pose(chain.dofs()), m_workspace(chain), m_firstDirty(0)
+		{
+			chain.readPose(m_pose.data()) ;
+		}
+
+		const CompiledKinematicChain & chain() const
+		{
+			return *m_chain ;
+		}
+
+		/// \brief	Number of degrees of freedom.
+		size_t size() const
+		{
+			return m_pose.size() ;
+		}
+
+		/// \brief	The values of the degrees of freedom.
+		const float * pose() const
+		{
+			return m_pose.data() ;
+		}
+
+		float operator[] (size_t dof) const
+		{
+			return m_pose[dof] ;
+		}
+
+		/// \brief	Sets a degree of freedom (clamped to its limits).
+		void set(int dof, float value)
+		{
+			m_pose[dof] = m_chain->limits(dof).clamp(value) ;
+			m_firstDirty = ::std::min(m_firstDirty, m_chain->dofNode(dof)) ;
+		}
+
+		/// \brief	Sets all the degrees of freedom (not clamped).
+		void setPose(const float * values)
+		{
+			::std::copy(values, values+m_pose.size(), m_pose.begin()) ;
+			m_firstDirty = 0 ;
+		}
+
+		/// \brief	Reads the pose of the original chain.
+		void read()
+		{
+			m_chain->readPose(m_pose.data()) ;
+			m_firstDirty = 0 ;
+		}
+
+		/// \brief	Writes the pose in the original chain (chain must be the compiled chain of this state).
+		void write(CompiledKinematicChain & chain) const
+		{
+			assert(&chain==m_chain) ;
+			chain.writePose(m_pose.data()) ;
+		}
+
+		bool upToDate() const
+		{
+			return size_t(m_firstDirty)>=m_chain->nodes() ;
+		}
+
+		/// \brief	Updates the transformations invalidated since the last update.
+		void update()
+		{
+			if(upToDate()) { return ; }
+			m_chain->forwardKinematics(m_pose.data(), m_workspace, m_firstDirty) ;
+			m_firstDirty = int(m_chain->nodes()) ;
+		}
+
+		/// \brief	Global transformation of a node (the state must be up to date).
+		const CompiledKinematicChain::AffineTransform & global(int node) const
+		{
+			assert(upToDate()) ;
+			return m_workspace.m_globals[node] ;
+		}
+
+		/// \brief	Position of a point (offset in the frame of node), the state must be up to date.
+		Math::Vector3f position(int node, const Math::Vector3f & offset) const
+		{
+			assert(upToDate()) ;
+			return m_chain->position(m_workspace, node, offset) ;
+		}
+
+		/// \brief	Analytic jacobian of a point (see CompiledKinematicChain::jacobian), the state must be up to date.
+		void jacobian(int node, const Math::Vector3f & offset, Math::Vector3f * columns) const
+		{
+			assert(upToDate()) ;
+			m_chain->jacobian(m_pose.data(), m_workspace, node, offset, columns) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Function, class Value> void KinematicState::derivatives(const Function & function,
+		/// 	float epsilon, Value * result, size_t grainSize = 4) const
+		///
+		/// \brief	Computes the derivatives of a function of the state with respect to each degree of
+		/// 		freedom by central finite differences (as KinematicChain::derivate, the perturbations are
+		/// 		clamped to the limits). The degrees of freedom are distributed by blocks on the TBB
+		/// 		worker threads, each block perturbs its own copy of the state, the forward kinematics
+		/// 		being only recomputed from the node of the perturbed degree of freedom.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Function	Value(const KinematicState &), called concurrently on up to date states.
+		/// \tparam	Value   	Type of the values of the function (float, Math::Vector3f...).
+		/// \param 		 	function 	The function.
+		/// \param 		 	epsilon  	The perturbation.
+		/// \param [in,out]	result   	The derivatives (size() values).
+		/// \param 		 	grainSize	(optional) The number of degrees of freedom per task.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Function, class Value>
+		void derivatives(const Function & function, float epsilon, Value * result, size_t grainSize = 4) const
+		{
+			const KinematicState & self = *this ;
+			::tbb::parallel_for(::tbb::blocked_range<int>(0, int(m_pose.size()), grainSize), [&self, &function, epsilon, result](const ::tbb::blocked_range<int> & range)
+			{
+				KinematicState state(self) ;
+				const KinematicState & perturbed = state ;
+				state.update() ;
+				for(int dof=range.begin() ; dof!=range.end() ; ++dof)
+				{
+					float reference = self.m_pose[dof] ;
+					state.set(dof, reference+epsilon) ;
+					float upper = state[dof] ;
+					state.update() ;
+					Value plus = function(perturbed) ;
+					state.set(dof, reference-epsilon) ;
+					float lower = state[dof] ;
+					state.update() ;
+					Value minus = function(perturbed) ;
+					// The next degrees of freedom belong to the same node or to the next ones: the restored
+					// value is taken into account by their update
+					state.m_pose[dof] = reference ;
+					state.m_firstDirty = ::std::min(state.m_firstDirty, self.m_chain->dofNode(dof)) ;
+					result[dof] = (upper>lower) ? (plus-minus)*(1.0f/(upper-lower)) : (plus-minus)*0.0f ;
+				}
+			}) ;
+		}
+	};
+}
+
+#endif
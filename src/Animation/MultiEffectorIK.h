@@ -0,0 +1,438 @@
+#ifndef _Animation_MultiEffectorIK_H
+#define _Animation_MultiEffectorIK_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Animation/DampedLeastSquaresIK.h>
+#include <Math/Matrix4x4f.h>
+#include <Math/Ldlt.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	MultiEffectorIK
+	///
+	/// \brief	Damped least squares inverse kinematics of several effectors of a compiled chain (full
+	/// 		body rigs). Each effector constrains the position of a point and / or the orientation of
+	/// 		a node. An iteration computes the forward kinematics once for all the effectors and
+	/// 		assembles one stacked jacobian (3 rows per position, 3 rows per orientation, weighted),
+	/// 		the normal equations are solved with a LDLt decomposition on the smallest side
+	/// 		(J.Jt + lambda^2.I if there are less rows than degrees of freedom, Jt.J + lambda^2.I
+	/// 		otherwise). The orientation error is the rotation vector (axis x angle) from the current
+	/// 		orientation to the target orientation. As DampedLeastSquaresIK, the damping decreases
+	/// 		when an iteration reduces the weighted error and increases otherwise. The memory is
+	/// 		allocated when effectors are added.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class MultiEffectorIK
+	{
+	public:
+		typedef DampedLeastSquaresIK::Result Result ;
+
+		/// \brief	Constraints of an effector.
+		enum Constraints { positionConstraint = 1, orientationConstraint = 2, poseConstraint = 3 } ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Effector
+		///
+		/// \brief	An effector and its targets.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Effector
+		{
+		public:
+			/// \brief	The index of the node in the compiled chain.
+			int m_node ;
+			/// \brief	The constrained point (in the frame of the node).
+			Math::Vector3f m_offset ;
+			/// \brief	The constraints (Constraints flags).
+			int m_constraints ;
+			/// \brief	The target position of the point.
+			Math::Vector3f m_targetPosition ;
+			/// \brief	The target orientation of the node (rotation part only).
+			CompiledKinematicChain::AffineTransform m_targetOrientation ;
+			/// \brief	The weight of the position rows.
+			float m_positionWeight ;
+			/// \brief	The weight of the orientation rows.
+			float m_orientationWeight ;
+			/// \brief	The first row of the effector in the stacked jacobian.
+			int m_firstRow ;
+
+			/// \brief	Number of rows in the stacked jacobian.
+			int rows() const
+			{
+				return ((m_constraints&positionConstraint) ? 3 : 0)+((m_constraints&orientationConstraint) ? 3 : 0) ;
+			}
+		};
+
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The effectors.
+		::std::vector<Effector> m_effectors ;
+		/// \brief	The number of rows of the stacked jacobian.
+		int m_rows ;
+		/// \brief	The stacked jacobian (row major, m_rows x dofs).
+		::std::vector<float> m_jacobian ;
+		/// \brief	The stacked weighted error of the current pose.
+		::std::vector<float> m_error ;
+		/// \brief	The stacked weighted error of the tried pose.
+		::std::vector<float> m_trialError ;
+		/// \brief	The columns computed for one effector.
+		::std::vector<Math::Vector3f> m_columns ;
+		/// \brief	The normal equations.
+		::std::vector<double> m_normal ;
+		/// \brief	The right hand side / solution of the normal equations.
+		::std::vector<double> m_solution ;
+		/// \brief	Forward kinematics of the current pose.
+		CompiledKinematicChain::Workspace m_current ;
+		/// \brief	Forward kinematics of the tried pose.
+		CompiledKinematicChain::Workspace m_trial ;
+		/// \brief	The tried pose.
+		::std::vector<float> m_trialPose ;
+		/// \brief	The damping factor (lambda).
+		float m_damping ;
+		/// \brief	The minimum and maximum values of the damping factor.
+		float m_minDamping, m_maxDamping ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector3f MultiEffectorIK::rotationError(const CompiledKinematicChain::AffineTransform & current,
+		/// 	const CompiledKinematicChain::AffineTransform & target)
+		///
+		/// \brief	Rotation vector (axis x angle, global frame) of target.current^t.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector3f rotationError(const CompiledKinematicChain::AffineTransform & current, const CompiledKinematicChain::AffineTransform & target)
+		{
+			float rotation[3][3] ;
+			for(int row=0 ; row<3 ; ++row)
+			{
+				for(int column=0 ; column<3 ; ++column)
+				{
+					rotation[row][column] = target.m_data[row][0]*current.m_data[column][0] + target.m_data[row][1]*current.m_data[column][1] + target.m_data[row][2]*current.m_data[column][2] ;
+				}
+			}
+			Math::Vector3f sine = Math::makeVector(rotation[2][1]-rotation[1][2], rotation[0][2]-rotation[2][0], rotation[1][0]-rotation[0][1])*0.5f ;
+			float cosine = (rotation[0][0]+rotation[1][1]+rotation[2][2]-1.0f)*0.5f ;
+			float sineNorm = sine.norm() ;
+			float angle = ::std::atan2(sineNorm, cosine) ;
+			if(sineNorm>1e-4f) { return sine*(angle/sineNorm) ; }
+			if(cosine>0.0f) { return sine ; }
+			// Angle close to pi: the axis is the column of rotation+I with the largest norm
+			float bestNorm = 0.0f ;
+			Math::Vector3f axis = Math::makeVector(1.0f, 0.0f, 0.0f) ;
+			for(int column=0 ; column<3 ; ++column)
+			{
+				Math::Vector3f candidate = Math::makeVector(rotation[0][column], rotation[1][column], rotation[2][column]) ;
+				candidate[column] += 1.0f ;
+				if(candidate.norm()>bestNorm) { bestNorm = candidate.norm() ; axis = candidate ; }
+			}
+			return axis*(angle/bestNorm) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float MultiEffectorIK::evaluate(const CompiledKinematicChain::Workspace & workspace, float * error,
+		/// 	float & positionError, float & orientationError) const
+		///
+		/// \brief	Computes the stacked weighted error of a pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	workspace		 	The forward kinematics of the pose.
+		/// \param [in,out]	error			 	The stacked weighted error.
+		/// \param [out]	positionError	 	The largest distance to a target position.
+		/// \param [out]	orientationError 	The largest angle to a target orientation.
+		///
+		/// \return	The squared norm of the weighted error.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float evaluate(const CompiledKinematicChain::Workspace & workspace, float * error, float & positionError, float & orientationError) const
+		{
+			positionError = 0.0f ;
+			orientationError = 0.0f ;
+			float cost = 0.0f ;
+			for(auto it=m_effectors.begin(), end=m_effectors.end() ; it!=end ; ++it)
+			{
+				float * rows = error+it->m_firstRow ;
+				if(it->m_constraints&positionConstraint)
+				{
+					Math::Vector3f delta = it->m_targetPosition-m_chain->position(workspace, it->m_node, it->m_offset) ;
+					positionError = ::std::max(positionError, delta.norm()) ;
+					for(int cpt=0 ; cpt<3 ; ++cpt) { rows[cpt] = delta[cpt]*it->m_positionWeight ; }
+					rows += 3 ;
+				}
+				if(it->m_constraints&orientationConstraint)
+				{
+					Math::Vector3f delta = rotationError(workspace.m_globals[it->m_node], it->m_targetOrientation) ;
+					orientationError = ::std::max(orientationError, delta.norm()) ;
+					for(int cpt=0 ; cpt<3 ; ++cpt) { rows[cpt] = delta[cpt]*it->m_orientationWeight ; }
+				}
+			}
+			for(int row=0 ; row<m_rows ; ++row) { cost += error[row]*error[row] ; }
+			return cost ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void MultiEffectorIK::stackJacobian(const float * pose)
+		///
+		/// \brief	Assembles the weighted stacked jacobian of the current pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void stackJacobian(const float * pose)
+		{
+			const size_t dofs = m_chain->dofs() ;
+			for(auto it=m_effectors.begin(), end=m_effectors.end() ; it!=end ; ++it)
+			{
+				float * row = m_jacobian.data()+size_t(it->m_firstRow)*dofs ;
+				if(it->m_constraints&positionConstraint)
+				{
+					m_chain->jacobian(pose, m_current, it->m_node, it->m_offset, m_columns.data()) ;
+					for(int cpt=0 ; cpt<3 ; ++cpt, row+=dofs)
+					{
+						for(size_t dof=0 ; dof<dofs ; ++dof) { row[dof] = m_columns[dof][cpt]*it->m_positionWeight ; }
+					}
+				}
+				if(it->m_constraints&orientationConstraint)
+				{
+					m_chain->angularJacobian(pose, m_current, it->m_node, m_columns.data()) ;
+					for(int cpt=0 ; cpt<3 ; ++cpt, row+=dofs)
+					{
+						for(size_t dof=0 ; dof<dofs ; ++dof) { row[dof] = m_columns[dof][cpt]*it->m_orientationWeight ; }
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool MultiEffectorIK::computeStep(const float * pose)
+		///
+		/// \brief	Computes the damped least squares step in m_trialPose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	false if the normal equations are degenerate.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool computeStep(const float * pose)
+		{
+			const int dofs = int(m_chain->dofs()) ;
+			const int rows = m_rows ;
+			const float * jacobian = m_jacobian.data() ;
+			const double damping2 = double(m_damping)*double(m_damping) ;
+			if(rows<=dofs)
+			{
+				// (J.Jt + lambda^2.I).y = error, dTheta = Jt.y (only the lower part is used)
+				for(int row=0 ; row<rows ; ++row)
+				{
+					for(int cpt=0 ; cpt<=row ; ++cpt)
+					{
+						double sum = 0.0 ;
+						for(int dof=0 ; dof<dofs ; ++dof) { sum += double(jacobian[row*dofs+dof])*double(jacobian[cpt*dofs+dof]) ; }
+						m_normal[row*rows+cpt] = sum ;
+					}
+					m_normal[row*rows+row] += damping2 ;
+					m_solution[row] = m_error[row] ;
+				}
+				if(!Math::ldltDecompose(m_normal.data(), rows)) { return false ; }
+				Math::ldltSolve(m_normal.data(), m_solution.data(), rows) ;
+				for(int dof=0 ; dof<dofs ; ++dof)
+				{
+					double step = 0.0 ;
+					for(int row=0 ; row<rows ; ++row) { step += double(jacobian[row*dofs+dof])*m_solution[row] ; }
+					m_trialPose[dof] = m_chain->limits(dof).clamp(pose[dof]+float(step)) ;
+				}
+			}
+			else
+			{
+				// (Jt.J + lambda^2.I).dTheta = Jt.error
+				for(int dof=0 ; dof<dofs ; ++dof)
+				{
+					for(int cpt=0 ; cpt<=dof ; ++cpt)
+					{
+						double sum = 0.0 ;
+						for(int row=0 ; row<rows ; ++row) { sum += double(jacobian[row*dofs+dof])*double(jacobian[row*dofs+cpt]) ; }
+						m_normal[dof*dofs+cpt] = sum ;
+					}
+					m_normal[dof*dofs+dof] += damping2 ;
+					double rhs = 0.0 ;
+					for(int row=0 ; row<rows ; ++row) { rhs += double(jacobian[row*dofs+dof])*double(m_error[row]) ; }
+					m_solution[dof] = rhs ;
+				}
+				if(!Math::ldltDecompose(m_normal.data(), dofs)) { return false ; }
+				Math::ldltSolve(m_normal.data(), m_solution.data(), dofs) ;
+				for(int dof=0 ; dof<dofs ; ++dof) { m_trialPose[dof] = m_chain->limits(dof).clamp(pose[dof]+float(m_solution[dof])) ; }
+			}
+			return true ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	MultiEffectorIK::MultiEffectorIK(const CompiledKinematicChain & chain)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	The compiled chain (must outlive this object).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		MultiEffectorIK(const CompiledKinematicChain & chain)
+			: m_chain(&chain), m_rows(0), m_columns(chain.dofs()), m_current(chain), m_trial(chain), m_trialPose(chain.dofs()),
+			  m_damping(0.1f), m_minDamping(0.001f), m_maxDamping(100.0f)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t MultiEffectorIK::addEffector(int node, int constraints,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), float positionWeight = 1.0f,
+		/// 	float orientationWeight = 1.0f)
+		///
+		/// \brief	Adds an effector. Its targets are its current position and orientation in the pose of
+		/// 		the original chain.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	node			 	The index of the node in the compiled chain.
+		/// \param	constraints		 	The constraints (Constraints flags).
+		/// \param	offset			 	(optional) The constrained point (in the frame of the node).
+		/// \param	positionWeight   	(optional) The weight of the position rows.
+		/// \param	orientationWeight	(optional) The weight of the orientation rows (per radian).
+		///
+		/// \return	The index of the effector.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t addEffector(int node, int constraints, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), float positionWeight = 1.0f, float orientationWeight = 1.0f)
+		{
+			assert(node>=0 && size_t(node)<m_chain->nodes()) ;
+			assert((constraints&poseConstraint)!=0) ;
+			::std::vector<float> pose(m_chain->dofs()) ;
+			m_chain->readPose(pose.data()) ;
+			m_chain->forwardKinematics(pose.data(), m_current) ;
+			Effector effector ;
+			effector.m_node = node ;
+			effector.m_offset = offset ;
+			effector.m_constraints = constraints&poseConstraint ;
+			effector.m_targetPosition = m_chain->position(m_current, node, offset) ;
+			effector.m_targetOrientation = m_current.m_globals[node] ;
+			effector.m_positionWeight = positionWeight ;
+			effector.m_orientationWeight = orientationWeight ;
+			effector.m_firstRow = m_rows ;
+			m_effectors.push_back(effector) ;
+			m_rows += effector.rows() ;
+			const size_t dofs = m_chain->dofs() ;
+			const size_t side = ::std::min(size_t(m_rows), dofs) ;
+			m_jacobian.resize(size_t(m_rows)*dofs) ;
+			m_error.resize(m_rows) ;
+			m_trialError.resize(m_rows) ;
+			m_normal.resize(side*side) ;
+			m_solution.resize(::std::max(size_t(m_rows), dofs)) ;
+			return m_effectors.size()-1 ;
+		}
+
+		size_t effectors() const
+		{
+			return m_effectors.size() ;
+		}
+
+		const Effector & effector(size_t index) const
+		{
+			return m_effectors[index] ;
+		}
+
+		/// \brief	Sets the target position of an effector.
+		void setTarget(size_t effector, const Math::Vector3f & position)
+		{
+			m_effectors[effector].m_targetPosition = position ;
+		}
+
+		/// \brief	Sets the target orientation of an effector (the translation of orientation is ignored).
+		void setTarget(size_t effector, const Math::Matrix4x4f & orientation)
+		{
+			m_effectors[effector].m_targetOrientation = CompiledKinematicChain::AffineTransform::fromMatrix(orientation) ;
+		}
+
+		/// \brief	Sets the target position and orientation of an effector.
+		void setTarget(size_t effector, const Math::Vector3f & position, const Math::Matrix4x4f & orientation)
+		{
+			setTarget(effector, position) ;
+			setTarget(effector, orientation) ;
+		}
+
+		/// \brief	Sets the damping factor and its bounds.
+		void setDamping(float initial, float minimum, float maximum)
+		{
+			assert(minimum>0.0f && minimum<=maximum) ;
+			m_minDamping = minimum ;
+			m_maxDamping = maximum ;
+			m_damping = ::std::max(minimum, ::std::min(maximum, initial)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Result MultiEffectorIK::solve(float * pose, unsigned int maxIterations, float tolerance,
+		/// 	float angularTolerance)
+		///
+		/// \brief	Moves the effectors toward their targets.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose				The pose (updated).
+		/// \param 		 	maxIterations   	The maximum number of iterations.
+		/// \param 		 	tolerance			The distance under which a target position is reached.
+		/// \param 		 	angularTolerance	The angle (radians) under which a target orientation is
+		/// 									reached.
+		///
+		/// \return	The number of iterations, the residual (largest distance to a target position) and
+		/// 		the convergence (all the targets are reached).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Result solve(float * pose, unsigned int maxIterations, float tolerance, float angularTolerance)
+		{
+			const size_t dofs = m_chain->dofs() ;
+			Result result ;
+			if(m_effectors.empty()) { result.m_converged = true ; return result ; }
+			float positionError, orientationError ;
+			m_chain->forwardKinematics(pose, m_current) ;
+			float cost = evaluate(m_current, m_error.data(), positionError, orientationError) ;
+			while((positionError>tolerance || orientationError>angularTolerance) && result.m_iterations<maxIterations)
+			{
+				++result.m_iterations ;
+				stackJacobian(pose) ;
+				// Can not fail with a strictly positive damping except with degenerate values
+				if(!computeStep(pose)) { break ; }
+				m_chain->forwardKinematics(m_trialPose.data(), m_trial) ;
+				float trialPositionError, trialOrientationError ;
+				float trialCost = evaluate(m_trial, m_trialError.data(), trialPositionError, trialOrientationError) ;
+				if(trialCost<cost)
+				{
+					::std::copy(m_trialPose.begin(), m_trialPose.begin()+dofs, pose) ;
+					::std::swap(m_current, m_trial) ;
+					m_error.swap(m_trialError) ;
+					cost = trialCost ;
+					positionError = trialPositionError ;
+					orientationError = trialOrientationError ;
+					m_damping = ::std::max(m_minDamping, m_damping*0.5f) ;
+				}
+				else
+				{
+					// The iteration is rejected, the damping increases (stuck if already maximal)
+					if(m_damping>=m_maxDamping) { break ; }
+					m_damping = ::std::min(m_maxDamping, m_damping*4.0f) ;
+				}
+			}
+			result.m_residual = positionError ;
+			result.m_converged = positionError<=tolerance && orientationError<=angularTolerance ;
+			return result ;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef _Animation_MultiStartIK_H
+#define _Animation_MultiStartIK_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Animation/DampedLeastSquaresIK.h>
+#include <Math/UniformRandom.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	MultiStartIK
+	///
+	/// \brief	Speculative multi-start inverse kinematics. The first start is the pose given by the
+	/// 		caller, the other ones are random perturbations of this pose (each value is interpolated
+	/// 		toward a uniform sample of its limits by the spread factor). The starts are solved
+	/// 		concurrently on the TBB worker threads by slices of a few iterations, each start owning
+	/// 		its pose and its solver: when a start converges, the other ones stop at the end of their
+	/// 		current slice. The kept pose is the converged start with the smallest index (the pose of
+	/// 		the caller if it converged), or the start with the smallest residual. Which of the other
+	/// 		starts converged depends on the scheduling of the threads.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \tparam	Solver	The solver (DampedLeastSquaresIK or Fabrik), built from (chain, extremity, offset)
+	/// 				and providing Result solve(float * pose, const Math::Vector3f & target,
+	/// 				unsigned int maxIterations, float tolerance).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <class Solver = DampedLeastSquaresIK>
+	class MultiStartIK
+	{
+	public:
+		typedef DampedLeastSquaresIK::Result Result ;
+
+	protected:
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	One solver per start.
+		::std::vector<Solver> m_solvers ;
+		/// \brief	The poses of the starts (m_chain->dofs() values per start).
+		::std::vector<float> m_poses ;
+		/// \brief	The results of the starts.
+		::std::vector<Result> m_results ;
+		/// \brief	The interpolation factor toward random poses.
+		float m_spread ;
+		/// \brief	The number of iterations of a slice.
+		unsigned int m_sliceIterations ;
+		/// \brief	The seed of the random generator.
+		::std::uint64_t m_seed ;
+		/// \brief	The number of calls to solve (the random starts change at each call).
+		::std::uint64_t m_calls ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	MultiStartIK::MultiStartIK(const CompiledKinematicChain & chain, int extremity, size_t starts,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), ::std::uint64_t seed = 0)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive this object).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	starts   	The number of starts (at least 1).
+		/// \param	offset   	(optional) The offset from the extremity.
+		/// \param	seed	 	(optional) The seed of the random generator.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		MultiStartIK(const CompiledKinematicChain & chain, int extremity, size_t starts, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f), ::std::uint64_t seed = 0)
+			: m_chain(&chain), m_solvers(::std::max<size_t>(starts, 1), Solver(chain, extremity, offset)), m_poses(::std::max<size_t>(starts, 1)*chain.dofs()),
+			  m_results(::std::max<size_t>(starts, 1)), m_spread(0.5f), m_sliceIterations(5), m_seed(seed), m_calls(0)
+		{}
+
+		/// \brief	Sets the interpolation factor toward random poses (1: uniform in the limits).
+		void setSpread(float spread)
+		{
+			m_spread = spread ;
+		}
+
+		/// \brief	Sets the number of iterations between two checks of the other starts.
+		void setSliceIterations(unsigned int sliceIterations)
+		{
+			m_sliceIterations = ::std::max(1u, sliceIterations) ;
+		}
+
+		size_t starts() const
+		{
+			return m_solvers.size() ;
+		}
+
+		/// \brief	The result of a start during the last call to solve.
+		const Result & result(size_t start) const
+		{
+			return m_results[start] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Result MultiStartIK::solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations,
+		/// 	float tolerance)
+		///
+		/// \brief	Moves the extremity toward the target.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose		 	The pose (replaced by the kept start).
+		/// \param 		 	target		 	The target.
+		/// \param 		 	maxIterations	The maximum number of iterations per start.
+		/// \param 		 	tolerance	 	The distance under which the target is reached.
+		///
+		/// \return	The result of the kept start.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Result solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations, float tolerance)
+		{
+			const size_t dofs = m_chain->dofs() ;
+			const ::std::uint64_t seed = m_seed+(m_calls++) ;
+			::std::atomic<bool> found(false) ;
+			MultiStartIK & self = *this ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_solvers.size(), 1), [&self, &found, pose, &target, maxIterations, tolerance, dofs, seed](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t start=range.begin() ; start!=range.end() ; ++start)
+				{
+					float * current = self.m_poses.data()+start*dofs ;
+					::std::copy(pose, pose+dofs, current) ;
+					if(start>0)
+					{
+						Math::UniformRandom random(seed, start) ;
+						for(size_t dof=0 ; dof<dofs ; ++dof)
+						{
+							const Math::Interval<float> & limits = self.m_chain->limits(int(dof)) ;
+							float sample = float(random(limits.inf(), limits.sup())) ;
+							current[dof] = limits.clamp(current[dof]+(sample-current[dof])*self.m_spread) ;
+						}
+					}
+					Result & result = self.m_results[start] ;
+					result = Result() ;
+					while(!found.load(::std::memory_order_relaxed) && result.m_iterations<maxIterations)
+					{
+						unsigned int slice = ::std::min(self.m_sliceIterations, maxIterations-result.m_iterations) ;
+						Result sliceResult = self.m_solvers[start].solve(current, target, slice, tolerance) ;
+						result.m_iterations += sliceResult.m_iterations ;
+						result.m_residual = sliceResult.m_residual ;
+						result.m_converged = sliceResult.m_converged ;
+						if(result.m_converged) { found = true ; }
+						// The solver is stuck
+						if(sliceResult.m_iterations<slice) { break ; }
+					}
+					// Stopped before the first slice: the residual is evaluated
+					if(result.m_iterations==0 && !result.m_converged) { result = self.m_solvers[start].solve(current, target, 0, tolerance) ; }
+					if(result.m_converged) { found = true ; }
+				}
+			}) ;
+			size_t best = 0 ;
+			for(size_t start=1 ; start<m_results.size() ; ++start)
+			{
+				const Result & candidate = m_results[start] ;
+				const Result & kept = m_results[best] ;
+				if(kept.m_converged) { break ; }
+				if(candidate.m_converged || candidate.m_residual<kept.m_residual) { best = start ; }
+			}
+			::std::copy(m_poses.begin()+best*dofs, m_poses.begin()+(best+1)*dofs, pose) ;
+			return m_results[best] ;
+		}
+	};
+}
+
+#endif
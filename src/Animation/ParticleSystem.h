@@ -2,11 +2,15 @@
 #define _Animation_ParticleSystem_H
 
 #include <Animation/Particle.h>
+#include <Animation/Physics.h>
 #include <Math/Sampler.h>
 #include <vector>
 #include <functional>
 #include <iterator>
-#include <tbb/parallel_for_each.h>
+#include <cassert>
+#include <cstdint>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
 #include <algorithm>
 
 namespace Animation
@@ -23,49 +27,255 @@ namespace Animation
 	{
 	public:
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \typedef	::std::back_insert_iterator<::std::vector<Particle>> ParticleInserter
+		/// \class	Range
 		///
-		/// \brief	Defines an alias representing the particle inserter used by particle emitters.
+		/// \brief	A contiguous range of particles stored in the particle pool.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	ParticleType	Type of the particle (Particle or const Particle).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class ParticleType>
+		class Range
+		{
+		protected:
+			ParticleType * m_begin ;
+			ParticleType * m_end ;
+
+		public:
+			Range(ParticleType * begin, ParticleType * end)
+				: m_begin(begin), m_end(end)
+			{}
+
+			ParticleType * begin() const { return m_begin ; }
+
+			ParticleType * end() const { return m_end ; }
+
+			size_t size() const { return m_end-m_begin ; }
+
+			bool empty() const { return m_begin==m_end ; }
+
+			ParticleType & operator[] (size_t index) const
+			{
+				assert(index<size()) ;
+				return m_begin[index] ;
+			}
+		};
+
+		/// \brief	Range of particles that can be modified (used by emitters).
+		typedef Range<Particle> ParticleRange ;
+		/// \brief	Read only range of particles.
+		typedef Range<const Particle> ConstParticleRange ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	ParticleAllocator
+		///
+		/// \brief	Allocator provided to the emitters. It reserves contiguous ranges of particles in the 
+		/// 		preallocated particle pool. Reserved particles are NOT initialized (they may contain 
+		/// 		a dead particle), the emitter must initialize all the attributes of the particles.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		typedef ::std::back_insert_iterator<::std::vector<Particle>> ParticleInserter ;
+		class ParticleAllocator
+		{
+		protected:
+			Particle * m_pool ;
+			size_t & m_size ;
+			size_t m_limit ;
+
+		public:
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	ParticleAllocator::ParticleAllocator(Particle * pool, size_t & size, size_t limit)
+			///
+			/// \brief	Constructor.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param 		   	pool 	The particle pool.
+			/// \param [in,out]	size 	The number of living particles in the pool.
+			/// \param 		   	limit	The capacity of the pool.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			ParticleAllocator(Particle * pool, size_t & size, size_t limit)
+				: m_pool(pool), m_size(size), m_limit(limit)
+			{}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	size_t ParticleAllocator::productionLimit() const
+			///
+			/// \brief	Gets the maximum number of particles that can still be allocated.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \return	The number of free particles in the pool (0 if the pool holds more than limit particles).
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			size_t productionLimit() const
+			{
+				return (m_size<m_limit) ? m_limit-m_size : 0 ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	ParticleRange ParticleAllocator::allocate(size_t number)
+			///
+			/// \brief	Reserves a contiguous range of particles. The number of reserved particles is clamped
+			/// 		by the production limit.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	number	The number of wanted particles.
+			///
+			/// \return	The reserved range, its size is min(number, productionLimit()).
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			ParticleRange allocate(size_t number)
+			{
+				number = ::std::min(number, productionLimit()) ;
+				Particle * begin = m_pool+m_size ;
+				m_size += number ;
+				return ParticleRange(begin, begin+number) ;
+			}
+		};
 
 	protected:
-		/// \brief	The particles.
+		/// \brief	The particle pool (preallocated with budget particles).
 		::std::vector<Particle> m_particles ;
+		/// \brief	The number of living particles, living particles are stored in m_particles[0..m_size).
+		size_t m_size ;
 		/// \brief The particle budget.
 		unsigned int m_budget ;
+		/// \brief	The effective budget (<= m_budget), limits the emission of the particles. It can be
+		/// 		lowered by the renderer when the particle system is not or hardly visible.
+		size_t m_effectiveBudget ;
+		
+		/// \brief	The grain size (number of particles per block) used for parallel updates.
+		size_t m_grainSize ;
 		
 		/// \brief	The modifiers applied to particles.
 		::std::vector<::std::function<void (float dt)>> m_modifiers;
 
-		/// \brief Death functions used to control life and death of the particles.
-		::std::vector<::std::function<void (::std::vector<size_t> &)>> m_deathQualifier ;
+		/// \brief Death functions used to control life and death of the particles. Each function marks 
+		/// 		the dead particles of the range [begin;end) in the associated flag array.
+		::std::vector<::std::function<void (const Particle * begin, const Particle * end, unsigned char * dead)>> m_deathQualifier ;
+
+		/// \brief	Death flags of the particles (one per particle, reused between updates).
+		::std::vector<unsigned char> m_deadFlags ;
+		/// \brief	Number of surviving particles per block.
+		::std::vector<size_t> m_blockAlive ;
+		/// \brief	Offsets of the holes (dead particles to be replaced) of each block.
+		::std::vector<size_t> m_holeOffsets ;
+		/// \brief	Offsets of the fillers (surviving particles to be moved) of each block.
+		::std::vector<size_t> m_fillerOffsets ;
+		/// \brief	Indexes of the holes.
+		::std::vector<size_t> m_holes ;
 
 		/// \brief The referenced particles emitters
-		::std::vector<::std::function<bool (ParticleInserter inserter, size_t productionLimit, float dt)>> m_emitters ;
+		::std::vector<::std::function<bool (ParticleAllocator & allocator, float dt)>> m_emitters ;
+
+		/// \brief	Identifiers of the particles (see identifiers). This array is a permutation of [0;budget): m_identifiers[i] is the identifier of the particle i
+		/// 		and the identifiers of the free particles are stored after m_size.
+		::std::vector<::std::uint32_t> m_identifiers ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystem::reserveBlocks()
+		///
+		/// \brief	Reserves the per block buffers given the budget and the grain size.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reserveBlocks()
+		{
+			size_t blocks = (m_budget+m_grainSize-1)/m_grainSize+1 ;
+			m_blockAlive.reserve(blocks) ;
+			m_holeOffsets.reserve(blocks) ;
+			m_fillerOffsets.reserve(blocks) ;
+		}
 
 	public:
-		ParticleSystem(unsigned int budget)
-			: m_budget(budget)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	ParticleSystem::ParticleSystem(unsigned int budget, size_t grainSize = 2000)
+		///
+		/// \brief	Constructor. All the memory used by the particles is allocated here, no allocation 
+		/// 		is done during updates.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	budget   	The particle budget.
+		/// \param	grainSize	(optional) the grain size used for parallel updates.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		ParticleSystem(unsigned int budget, size_t grainSize = 2000)
+			: m_particles(budget), m_size(0), m_budget(budget), m_effectiveBudget(budget), m_grainSize(::std::max<size_t>(grainSize, 1)), 
+			  m_deadFlags(budget), m_holes(budget), m_identifiers(budget)
+		{
+			reserveBlocks() ;
+			for(size_t cpt=0 ; cpt<m_identifiers.size() ; ++cpt) { m_identifiers[cpt] = (::std::uint32_t)cpt ; }
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual ParticleSystem::~ParticleSystem()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual ~ParticleSystem()
 		{}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	const ::std::vector<Particle> ParticleSystem::getParticles() const
+		/// \fn	void ParticleSystem::setGrainSize(size_t grainSize)
+		///
+		/// \brief	Sets the grain size i.e. the number of particles processed by a task during parallel 
+		/// 		updates (parallel modifiers and death qualification).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	grainSize	The grain size (clamped to 1).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setGrainSize(size_t grainSize)
+		{
+			m_grainSize = ::std::max<size_t>(grainSize, 1) ;
+			reserveBlocks() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t ParticleSystem::grainSize() const
 		///
-		/// \brief	Gets the particles (read only).
+		/// \brief	Gets the grain size used for parallel updates.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The grain size.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t grainSize() const
+		{
+			return m_grainSize ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	ConstParticleRange ParticleSystem::getParticles() const
+		///
+		/// \brief	Gets the living particles (read only).
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	17/12/2015
 		///
 		/// \return	The particles.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		const ::std::vector<Particle> & getParticles() const
+		ConstParticleRange getParticles() const
 		{
-			return m_particles ;
+			return ConstParticleRange(m_particles.data(), m_particles.data()+m_size) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	template <class ParticleModifier> void ParticleSystem::addModifier(const ParticleModifier & modifier)
+		/// \fn	template <class ParticleModifier> void ParticleSystem::addModifier(const ParticleModifier & modifier,
+		/// 	bool parallel=false)
 		///
 		/// \brief	Adds a modifier. A modifier MUST be a functor which type is : void (Particle &, float)
 		///
@@ -74,31 +284,144 @@ namespace Animation
 		///
 		/// \tparam	ParticleModifier	Type of the particle modifier.
 		/// \param	modifier	The modifier. void (const Particle & particle, float dt)
+		/// \param	parallel	(optional) True if the modifier must run in parallel (blocks of grainSize() 
+		/// 					particles), false otherwise. A parallel modifier must not modify shared data.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		template <class ParticleModifier>
-		void addModifier(ParticleModifier modifier)
+		void addModifier(ParticleModifier modifier, bool parallel = false)
 		{
-			auto func = [this, modifier](float dt) 
-				{ 
-					for(auto it=m_particles.begin() ; it!=m_particles.end() ; ++it)
+			if(!parallel) // Non parallel version of the modifier
+			{
+				auto func = [this, modifier](float dt) 
+					{ 
+						for(auto it=m_particles.begin(), end=m_particles.begin()+m_size ; it!=end ; ++it)
+						{
+							modifier(*it, dt) ;
+						}
+					} ;
+				m_modifiers.push_back(func) ;
+			}
+			else // Parallel version of the modifier
+			{
+				auto func = [this, modifier](float dt) 
+					{ 
+						auto & refModifier = modifier ;
+						::std::vector<Particle> & particles = m_particles ;
+						auto subFunction = [&refModifier, &particles, dt](::tbb::blocked_range<size_t> const & range)
+						{
+							for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+							{
+								refModifier(particles[cpt], dt) ;
+							}
+						} ;
+						::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_size, m_grainSize), subFunction) ;
+					} ; 
+				m_modifiers.push_back(func) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class SystemModifier> void ParticleSystem::addSystemModifier(SystemModifier modifier)
+		///
+		/// \brief	Adds a system modifier i.e. a functor called once per update with all the living 
+		/// 		particles: void (ConstParticleRange particles, float dt). System modifiers are called
+		/// 		in the same sequence as the modifiers (in order of insertion), they are used to 
+		/// 		compute data depending on several particles (acceleration structures, aggregates...)
+		/// 		which are then used by the following modifiers.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	SystemModifier	Type of the system modifier.
+		/// \param	modifier	The modifier: void (ConstParticleRange particles, float dt)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class SystemModifier>
+		void addSystemModifier(SystemModifier modifier)
+		{
+			m_modifiers.push_back([this, modifier](float dt) { modifier(getParticles(), dt) ; }) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Force> void ParticleSystem::addForce(Force force, bool parallel = false)
+		///
+		/// \brief	Adds a force functor (see Physics.h): Math::Vector3f (const PonctualMass & particle). The
+		/// 		returned force is added to the forces of each particle. If the functor also provides
+		/// 		the batch evaluation (see Physics::HasMassBatch), particles are processed by batches.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Force	Type of the force.
+		/// \param	force   	The force.
+		/// \param	parallel	(optional) True if the force must be evaluated in parallel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Force>
+		void addForce(Force force, bool parallel = false)
+		{
+			addForce(force, parallel, typename Physics::HasMassBatch<Force>::type()) ;
+		}
+
+	protected:
+		/// \brief	Buffer used by the batch evaluation of forces.
+		typedef Physics::MassBatchBuffer<256> BatchBuffer ;
+
+		template <class Force>
+		void addForce(Force force, bool parallel, ::std::false_type)
+		{
+			addModifier([force](Particle & particle, float) { particle.m_forces += force(particle) ; }, parallel) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Force> static void ParticleSystem::applyForceBatch(const Force & force, Particle * particles, size_t begin, size_t end)
+		///
+		/// \brief	Gathers the particles [begin;end) by batches, evaluates the batch force and adds the
+		/// 		result to the forces of the particles.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Force>
+		static void applyForceBatch(const Force & force, Particle * particles, size_t begin, size_t end)
+		{
+			BatchBuffer buffer ;
+			for(size_t first=begin ; first<end ; first+=BatchBuffer::maxSize)
+			{
+				Particle * batch = particles+first ;
+				buffer.load(end-first, [batch](size_t index) -> const Particle & { return batch[index] ; }) ;
+				force(buffer.masses(), buffer.forces()) ;
+				for(size_t cpt=0 ; cpt<buffer.size() ; ++cpt) { batch[cpt].m_forces += buffer.force(cpt) ; }
+			}
+		}
+
+		template <class Force>
+		void addForce(Force force, bool parallel, ::std::true_type)
+		{
+			if(!parallel)
+			{
+				m_modifiers.push_back([this, force](float) { applyForceBatch(force, m_particles.data(), 0, m_size) ; }) ;
+			}
+			else
+			{
+				m_modifiers.push_back([this, force](float)
+				{
+					auto & refForce = force ;
+					Particle * particles = m_particles.data() ;
+					::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_size, m_grainSize), [&refForce, particles](::tbb::blocked_range<size_t> const & range)
 					{
-						modifier(*it, dt) ;
-					}
-				} ;
-			//auto func = [this, modifier](float dt) 
-			//{ 
-			//	auto & refModifier = modifier ;
-			//	auto subFunction = [&dt, refModifier](Particle & particle) { refModifier(particle, dt); } ;
-			//	::tbb::parallel_for_each(m_particles.begin(), m_particles.end(), subFunction) ;
-			//} ; 
-			m_modifiers.push_back(func) ;
+						applyForceBatch(refForce, particles, range.begin(), range.end()) ;
+					}) ;
+				}) ;
+			}
 		}
 
+	public:
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	template <class DeathFunction> void ParticleSystem::addDeathFunction(DeathFunction deathFunction)
 		///
 		/// \brief	Adds a death function to the particle system. deathFunction MUST be a functor which type
-		/// 		is: bool (const Particle & particle)
+		/// 		is: bool (const Particle & particle). Death functions are evaluated in parallel (all 
+		/// 		the death functions are evaluated during the same pass), they must not modify shared data.
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	15/12/2015
@@ -109,12 +432,11 @@ namespace Animation
 		template <class DeathFunction>
 		void addDeathFunction(DeathFunction deathFunction)
 		{
-			auto func = [this, deathFunction] (::std::vector<size_t> & deadVector) -> void
+			auto func = [deathFunction] (const Particle * begin, const Particle * end, unsigned char * dead) -> void
 				{
-					for(auto it=m_particles.begin() ; it!=m_particles.end() ; ++it)
+					for(const Particle * it=begin ; it!=end ; ++it, ++dead)
 					{
-						bool dead = deathFunction(::std::cref(*it)) ;
-						if(dead) { deadVector.push_back(it-m_particles.begin()) ; }
+						(*dead) |= (unsigned char)deathFunction(*it) ;
 					}
 				} ;
 			m_deathQualifier.push_back(func) ;
@@ -126,19 +448,19 @@ namespace Animation
 		/// \brief	Adds an emitter to the particle system. 
 		/// 		
 		/// 		EmitterFunction is a functor which prototype is: 
-		/// 		bool (ParticleInserter inserter, size_t productionLimit, float dt)
+		/// 		bool (ParticleAllocator & allocator, float dt)
 		/// 		If this function returns false, no more particles will be emitted by this emitter. In this
 		/// 		case, the emitter is immediately removed from the system. 
-		/// 		Parameter inserter: a back insert iterator used to produce particles.
-		/// 		Parameter productionLimit: the maximum number of particles that can be generated, if 
-		/// 		too much particles are produced, the surplus will be deleted. 
+		/// 		Parameter allocator: the allocator used to reserve particles in the particle pool. The 
+		/// 		number of reserved particles is clamped by the production limit (allocator.productionLimit())
+		/// 		and reserved particles must be fully initialized by the emitter.
 		/// 		Parameter dt: the elapsed time since last call.
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	15/12/2015
 		///
 		/// \tparam	EmitterFunction	Type of the emitter function.
-		/// \param	emitter	The emitter function : bool (ParticleInserter inserter, size_t productionLimit, float dt)
+		/// \param	emitter	The emitter function : bool (ParticleAllocator & allocator, float dt)
 		////////////////////////////////////////////////////////////////////////////////////////////////////		
 		template <class EmitterFunction>
 		void addEmitter(EmitterFunction emitter)
@@ -162,16 +484,170 @@ namespace Animation
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	void ParticleSystem::update(float dt)
+		/// \fn	void ParticleSystem::setEffectiveBudget(size_t effectiveBudget)
+		///
+		/// \brief	Sets the effective budget: emitters cannot allocate particles when the number of living
+		/// 		particles reaches this budget. Living particles are not killed when the effective budget
+		/// 		is lowered, the system shrinks as they die.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	effectiveBudget	The effective budget (clamped to the budget).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setEffectiveBudget(size_t effectiveBudget)
+		{
+			m_effectiveBudget = ::std::min<size_t>(effectiveBudget, m_budget) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t ParticleSystem::effectiveBudget() const
+		///
+		/// \brief	Gets the effective budget.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The effective budget.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t effectiveBudget() const
+		{
+			return m_effectiveBudget ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::uint32_t * ParticleSystem::identifiers() const
+		///
+		/// \brief	Gets the identifiers of the particles. Each particle has an identifier in [0;budget)
+		/// 		that follows the particle as it is moved in the pool (removal of the dead particles,
+		/// 		reordering by derived particle systems such as SphFluid). The identifier of a dead
+		/// 		particle is reused by a particle emitted later.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	An array of budget() identifiers, identifiers()[i] is the identifier of the particle i.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::uint32_t * identifiers() const
+		{
+			return m_identifiers.data() ;
+		}
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystem::removeDeadParticles()
+		///
+		/// \brief	Removes the dead particles. This is done in parallel and in place: 
+		/// 		1 - all death qualifiers are evaluated on each block of particles and the surviving 
+		/// 		particles of the block are counted, the prefix sum of these counts gives the new number
+		/// 		of particles, 2 - prefix sums on the number of holes (dead particles before the new end)
+		/// 		and fillers (surviving particles after the new end) of each block give their ranks,
+		/// 		3 - indexes of the holes are collected, 4 - each filler is moved in the hole of same rank.
+		/// 		Only the surviving particles stored after the new end are moved. The identifiers of
+		/// 		a filler and of its hole are swapped.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void removeDeadParticles()
+		{
+			if(m_deathQualifier.empty() || m_size==0) { return ; }
+			const size_t size = m_size ;
+			const size_t grainSize = m_grainSize ;
+			const size_t blocks = (size+grainSize-1)/grainSize ;
+			m_blockAlive.resize(blocks) ;
+			Particle * particles = m_particles.data() ;
+			unsigned char * deadFlags = m_deadFlags.data() ;
+			size_t * blockAlive = m_blockAlive.data() ;
+			const auto & qualifiers = m_deathQualifier ;
+			// 1 - Fused evaluation of the death qualifiers and count of the survivors of each block
+			::tbb::parallel_for((size_t)0, blocks, [particles, deadFlags, blockAlive, &qualifiers, size, grainSize](size_t block)
+			{
+				size_t begin = block*grainSize ;
+				size_t end = ::std::min(begin+grainSize, size) ;
+				::std::fill(deadFlags+begin, deadFlags+end, (unsigned char)0) ;
+				for(auto it=qualifiers.begin() ; it!=qualifiers.end() ; ++it)
+				{
+					(*it)(particles+begin, particles+end, deadFlags+begin) ;
+				}
+				size_t alive = 0 ;
+				for(size_t cpt=begin ; cpt<end ; ++cpt) { alive += (deadFlags[cpt]==0) ; }
+				blockAlive[block] = alive ;
+			}) ;
+			size_t total = 0 ;
+			for(size_t block=0 ; block<blocks ; ++block) { total += blockAlive[block] ; }
+			if(total==size) { return ; } // Nobody died
+			// 2 - Exclusive prefix sums on the number of holes and fillers per block
+			m_holeOffsets.resize(blocks+1) ;
+			m_fillerOffsets.resize(blocks+1) ;
+			size_t * holeOffsets = m_holeOffsets.data() ;
+			size_t * fillerOffsets = m_fillerOffsets.data() ;
+			size_t holes = 0, fillers = 0 ;
+			for(size_t block=0 ; block<blocks ; ++block)
+			{
+				size_t begin = block*grainSize ;
+				size_t end = ::std::min(begin+grainSize, size) ;
+				holeOffsets[block] = holes ;
+				fillerOffsets[block] = fillers ;
+				if(end<=total) { holes += (end-begin)-blockAlive[block] ; }
+				else if(begin>=total) { fillers += blockAlive[block] ; }
+				else // The block containing the new end
+				{
+					for(size_t cpt=begin ; cpt<total ; ++cpt) { holes += (deadFlags[cpt]!=0) ; }
+					for(size_t cpt=total ; cpt<end ; ++cpt) { fillers += (deadFlags[cpt]==0) ; }
+				}
+			}
+			holeOffsets[blocks] = holes ;
+			fillerOffsets[blocks] = fillers ;
+			assert(holes==fillers) ;
+			// 3 - Collection of the holes
+			size_t * holeIndexes = m_holes.data() ;
+			const size_t lastHoleBlock = (total+grainSize-1)/grainSize ;
+			::tbb::parallel_for((size_t)0, lastHoleBlock, [deadFlags, holeOffsets, holeIndexes, total, grainSize](size_t block)
+			{
+				size_t begin = block*grainSize ;
+				size_t end = ::std::min(begin+grainSize, total) ;
+				size_t * destination = holeIndexes+holeOffsets[block] ;
+				for(size_t cpt=begin ; cpt<end ; ++cpt)
+				{
+					if(deadFlags[cpt]!=0) { *destination = cpt ; ++destination ; }
+				}
+			}) ;
+			// 4 - Fillers are moved in the holes
+			const size_t firstFillerBlock = total/grainSize ;
+			::std::uint32_t * identifiers = m_identifiers.data() ;
+			::tbb::parallel_for(firstFillerBlock, blocks, [particles, identifiers, deadFlags, fillerOffsets, holeIndexes, total, size, grainSize](size_t block)
+			{
+				size_t begin = ::std::max(block*grainSize, total) ;
+				size_t end = ::std::min(block*grainSize+grainSize, size) ;
+				const size_t * hole = holeIndexes+fillerOffsets[block] ;
+				for(size_t cpt=begin ; cpt<end ; ++cpt)
+				{
+					if(deadFlags[cpt]==0)
+					{
+						particles[*hole] = particles[cpt] ;
+						// The identifier of the dead particle is freed
+						::std::swap(identifiers[*hole], identifiers[cpt]) ;
+						++hole ;
+					}
+				}
+			}) ;
+			m_size = total ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void ParticleSystem::update(float dt)
 		///
-		/// \brief	Updates the particle system.
+		/// \brief	Updates the particle system. This method can be overridden by particle systems 
+		/// 		computing interactions between particles (see SphFluid).
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	15/12/2015
 		///
 		/// \param	dt	The dt.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void update(float dt)
+		virtual void update(float dt)
 		{
 			// Evolution of the particles
 			for(auto it=m_modifiers.begin(); it!=m_modifiers.end() ; ++it)
@@ -179,25 +655,13 @@ namespace Animation
 				(*it)(dt) ;
 			}
 			// Life and death
-			::std::vector<size_t> deathVector ;
-			for(auto it=m_deathQualifier.begin() ; it!=m_deathQualifier.end() ; ++it)
-			{
-				(*it)(deathVector) ; // Note that death vector is sorted in increasing order (consequence of the algorithm)
-				for(auto itDeath = deathVector.rbegin() ; itDeath!=deathVector.rend() ; ++itDeath)
-				{
-					m_particles[*itDeath] = m_particles.back() ; 
-					m_particles.pop_back() ;
-				}
-				deathVector.erase(deathVector.begin(), deathVector.end()) ;
-			}
+			removeDeadParticles() ;
 			// Emission
-			for(auto it=m_emitters.begin() ; it!=m_emitters.end() ; ++it)
+			ParticleAllocator allocator(m_particles.data(), m_size, m_effectiveBudget) ;
+			for(auto it=m_emitters.begin() ; it!=m_emitters.end() ; )
 			{
-				(*it)(::std::back_inserter(m_particles), m_budget-m_particles.size(), dt) ;
-				if(m_particles.size()>m_budget) // We enforce the budget
-				{
-					m_particles.erase(m_particles.begin()+m_budget, m_particles.end()) ;
-				}
+				if((*it)(allocator, dt)) { ++it ; }
+				else { it = m_emitters.erase(it) ; }
 			}
 		}
 
@@ -353,7 +817,7 @@ namespace Animation
 			/// \param	emissionRate	The emission rate (number of particles per second).
 			////////////////////////////////////////////////////////////////////////////////////////////////////
 			RateEmitterBase(float emissionRate)
-				: m_emissionRate(emissionRate)
+				: m_emissionRate(emissionRate), m_dateFraction(0.0f)
 			{}
 		};
 
@@ -405,49 +869,76 @@ namespace Animation
 			float m_radius ;
 			Math::Interval<float> m_speed ;
 			Math::Interval<float> m_lifeTime ;
+			/// \brief	The random stream of this emitter.
+			::std::uint64_t m_stream ;
+			/// \brief	The number of emissions since creation.
+			::std::uint64_t m_emissions ;
 
 		public:
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	BallFlowEmitter::BallFlowEmitter(Math::Vector3f const & center, float radius,
+			/// 	float emissionRate, Math::Interval<float> const & speed,
+			/// 	Math::Interval<float> const & lifeTime,
+			/// 	::std::uint64_t stream = Math::RandomGenerator::newStream())
+			///
+			/// \brief	Constructor.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/12/2015
+			///
+			/// \param	center			The center of the ball.
+			/// \param	radius			The radius of the ball.
+			/// \param	emissionRate	The emission rate (number of particles per second).
+			/// \param	speed			The interval of the initial speed.
+			/// \param	lifeTime		The interval of the life time.
+			/// \param	stream			(optional) the random stream of the emitter. Two emitters with the same
+			/// 						stream and the same parameters emit the same particles.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
 			BallFlowEmitter(Math::Vector3f const & center, float radius, float emissionRate,
-						    Math::Interval<float> const & speed, Math::Interval<float> const & lifeTime)
-				: RateEmitterBase(emissionRate), m_center(center), m_radius(radius), m_speed(speed), m_lifeTime(lifeTime)
+						    Math::Interval<float> const & speed, Math::Interval<float> const & lifeTime, 
+							::std::uint64_t stream = Math::RandomGenerator::newStream())
+				: RateEmitterBase(emissionRate), m_center(center), m_radius(radius), m_speed(speed), m_lifeTime(lifeTime),
+				  m_stream(stream), m_emissions(0)
 			{}
 
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			/// \fn	template <class ParticleInitializer> bool BallFlowEmitter::emit(ParticleInserter inserter,
-			/// 	size_t productionLimit, float dt)
+			/// \fn	bool BallFlowEmitter::operator() (ParticleAllocator & allocator, float dt)
 			///
-			/// \brief	Emits a particle located inside a ball.
+			/// \brief	Emits particles located on a sphere. The particles are directly initialized in the 
+			/// 		particle pool, in parallel by blocks of 1024 particles. Each block uses its own random
+			/// 		generator, deterministically seeded with the stream of the emitter, the emission 
+			/// 		index and the block index: the result does not depend on the scheduling.
 			///
 			/// \author	F. Lamarche, Universit de Rennes 1
 			/// \date	18/12/2015
 			///
-			/// \tparam	ParticleInitializer	Type of the particle initializer. This is a functor of type :
-			/// 							Particle (Math::Vector3 const & position)
-			/// 							This functor should initialize the position of the particle with
-			/// 							the provided one and decide of the values of the remaining 
-			/// 							parameters.
-			/// \param	inserter	   	The inserter in the particle structure.
-			/// \param	productionLimit	The production limit.
-			/// \param	dt			   	The dt.
+			/// \param	allocator	The allocator of the particle system.
+			/// \param	dt		 	The dt.
 			///
 			/// \return	true to always produce particles.
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			bool operator() (ParticleInserter inserter, size_t productionLimit, float dt)
+			bool operator() (ParticleAllocator & allocator, float dt)
 			{
-				unsigned int toEmit = ::std::min(productionLimit, numberOfParticles(dt)) ;
-				for(unsigned int cpt=0 ; cpt<toEmit ; ++cpt)
+				ParticleRange particles = allocator.allocate(numberOfParticles(dt)) ;
+				enum { blockSize = 1024 } ;
+				const size_t blocks = (particles.size()+blockSize-1)/blockSize ;
+				const ::std::uint64_t emission = m_emissions++ ;
+				auto emitBlock = [this, &particles, emission](size_t block)
 				{
-					Math::Vector3f direction = Math::Sampler::sphere() ;
-					Math::Vector3f position = m_center+direction*m_radius ;
-					Math::Vector3f speed = direction*m_speed.random() ;
-					Particle current ; //= ParticleInitializer(position) ;
-					current.m_position = position ;
-					current.m_speed = speed ;
-					current.m_lifeTimeLimit = m_lifeTime.random();
-					current.m_color = HelperGl::Color(1.0f,1.0f,1.0f);
-					(*inserter) = current ;
-					++inserter; 
-				}
+					Math::RandomGenerator generator(m_stream, (emission<<24) ^ block) ;
+					Particle * begin = particles.begin()+block*blockSize ;
+					Particle * end = particles.begin()+::std::min(particles.size(), (block+1)*blockSize) ;
+					Math::Vector3f directions[blockSize] ;
+					Math::Sampler::sphere(generator, directions, end-begin) ;
+					const Math::Vector3f * direction = directions ;
+					for(Particle * current=begin ; current!=end ; ++current, ++direction)
+					{
+						Math::Vector3f position = m_center+(*direction)*m_radius ;
+						(*current) = Particle(position, 1.0f, HelperGl::Color(1.0f,1.0f,1.0f), m_lifeTime.random(generator)) ;
+						current->m_speed = (*direction)*m_speed.random(generator) ;
+					}
+				} ;
+				::tbb::parallel_for((size_t)0, blocks, emitBlock) ;
 				return true ;
 			}
 		};
@@ -2,11 +2,185 @@
 #define _Animation_Physics_H
 
 #include <Animation/PonctualMass.h>
+#include <type_traits>
+#include <utility>
+#include <cmath>
+#include <cstddef>
 
 namespace Animation
 {
 	namespace Physics
 	{
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	MassBatch
+		///
+		/// \brief	Structure of arrays view of a batch of masses, used by the batch evaluation of the
+		/// 		forces. Each array contains m_size values.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class MassBatch
+		{
+		public:
+			/// \brief	The positions (one array per coordinate).
+			const float * m_position[3] ;
+			/// \brief	The speeds (one array per coordinate).
+			const float * m_speed[3] ;
+			/// \brief	The forces (one array per coordinate).
+			const float * m_forces[3] ;
+			/// \brief	The masses.
+			const float * m_mass ;
+			/// \brief	The number of masses.
+			size_t m_size ;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	ForceBatch
+		///
+		/// \brief	Structure of arrays output of the batch evaluation of the forces.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class ForceBatch
+		{
+		public:
+			/// \brief	The forces (one array per coordinate).
+			float * m_force[3] ;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	MassBatchBuffer
+		///
+		/// \brief	Storage of a batch of at most capacity masses (and of their forces) gathered from an
+		/// 		array of structures. Buffers are meant to be allocated on the stack, by each task.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	capacity	The maximum number of masses.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <size_t capacity>
+		class MassBatchBuffer
+		{
+		protected:
+			float m_position[3][capacity] ;
+			float m_speed[3][capacity] ;
+			float m_forces[3][capacity] ;
+			float m_mass[capacity] ;
+			float m_output[3][capacity] ;
+			size_t m_size ;
+
+		public:
+			enum { maxSize = capacity } ;
+
+			MassBatchBuffer()
+				: m_size(0)
+			{}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	template <class MassAccessor> void MassBatchBuffer::load(size_t size, const MassAccessor & accessor)
+			///
+			/// \brief	Gathers size masses, accessor(i) returns the i-th mass (a PonctualMass).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			template <class MassAccessor>
+			void load(size_t size, const MassAccessor & accessor)
+			{
+				m_size = (size<capacity) ? size : capacity ;
+				for(size_t cpt=0 ; cpt<m_size ; ++cpt)
+				{
+					const PonctualMass & mass = accessor(cpt) ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						m_position[axis][cpt] = mass.m_position[axis] ;
+						m_speed[axis][cpt] = mass.m_speed[axis] ;
+						m_forces[axis][cpt] = mass.m_forces[axis] ;
+					}
+					m_mass[cpt] = mass.m_mass ;
+				}
+			}
+
+			size_t size() const
+			{
+				return m_size ;
+			}
+
+			MassBatch masses() const
+			{
+				MassBatch result ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					result.m_position[axis] = m_position[axis] ;
+					result.m_speed[axis] = m_speed[axis] ;
+					result.m_forces[axis] = m_forces[axis] ;
+				}
+				result.m_mass = m_mass ;
+				result.m_size = m_size ;
+				return result ;
+			}
+
+			ForceBatch forces()
+			{
+				ForceBatch result ;
+				for(int axis=0 ; axis<3 ; ++axis) { result.m_force[axis] = m_output[axis] ; }
+				return result ;
+			}
+
+			Math::Vector3f force(size_t index) const
+			{
+				return Math::makeVector(m_output[0][index], m_output[1][index], m_output[2][index]) ;
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	HasMassBatch
+		///
+		/// \brief	HasMassBatch<Force>::value is true if Force provides the batch evaluation
+		/// 		void operator() (const MassBatch & masses, const ForceBatch & forces) const.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Force>
+		class HasMassBatch
+		{
+			template <class F>
+			static auto test(int) -> decltype(::std::declval<const F &>()(::std::declval<const MassBatch &>(), ::std::declval<const ForceBatch &>()), ::std::true_type()) ;
+			template <class F>
+			static ::std::false_type test(...) ;
+
+		public:
+			typedef decltype(test<Force>(0)) type ;
+			enum { value = type::value } ;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	HasLinkBatch
+		///
+		/// \brief	HasLinkBatch<Force>::value is true if Force provides the batch evaluation of link forces
+		/// 		void operator() (const MassBatch & masses1, const MassBatch & masses2, const float * lengths,
+		/// 		const ForceBatch & forces) const.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Force>
+		class HasLinkBatch
+		{
+			template <class F>
+			static auto test(int) -> decltype(::std::declval<const F &>()(::std::declval<const MassBatch &>(), ::std::declval<const MassBatch &>(), ::std::declval<const float *>(), ::std::declval<const ForceBatch &>()), ::std::true_type()) ;
+			template <class F>
+			static ::std::false_type test(...) ;
+
+		public:
+			typedef decltype(test<Force>(0)) type ;
+			enum { value = type::value } ;
+		};
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \class	WeightForce
 		///
@@ -50,6 +224,29 @@ namespace Animation
 			{
 				return mass.m_forces + Math::makeVector(0.0f,0.0f,-mass.m_mass * m_gravity) ;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void WeightForce::operator() (const MassBatch & masses, const ForceBatch & forces) const
+			///
+			/// \brief	Batch computation of the force (same result as the scalar version for each mass).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void operator() (const MassBatch & masses, const ForceBatch & forces) const
+			{
+				const float gravity = m_gravity ;
+				const float * mass = masses.m_mass ;
+				const float * inZ = masses.m_forces[2] ;
+				float * outZ = forces.m_force[2] ;
+				for(int axis=0 ; axis<2 ; ++axis)
+				{
+					const float * in = masses.m_forces[axis] ;
+					float * out = forces.m_force[axis] ;
+					for(size_t cpt=0 ; cpt<masses.m_size ; ++cpt) { out[cpt] = in[cpt] ; }
+				}
+				for(size_t cpt=0 ; cpt<masses.m_size ; ++cpt) { outZ[cpt] = inZ[cpt]-mass[cpt]*gravity ; }
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -85,6 +282,25 @@ namespace Animation
 			{
 				return mass.m_speed*(-m_dampingCoefficient) ;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void DampingForce::operator() (const MassBatch & masses, const ForceBatch & forces) const
+			///
+			/// \brief	Batch computation of the force.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void operator() (const MassBatch & masses, const ForceBatch & forces) const
+			{
+				const float coefficient = -m_dampingCoefficient ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					const float * speed = masses.m_speed[axis] ;
+					float * out = forces.m_force[axis] ;
+					for(size_t cpt=0 ; cpt<masses.m_size ; ++cpt) { out[cpt] = speed[cpt]*coefficient ; }
+				}
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,7 +341,7 @@ namespace Animation
 			{}
 
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			/// \fn	Math::Vector3f AttractionForce::operator() (PonctualMass & particle) const
+			/// \fn	Math::Vector3f AttractionForce::operator() (const PonctualMass & particle) const
 			///
 			/// \brief	 Computes the force.
 			///
@@ -134,7 +350,7 @@ namespace Animation
 			///
 			/// \return	The force.
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			Math::Vector3f operator() (PonctualMass & particle) const
+			Math::Vector3f operator() (const PonctualMass & particle) const
 			{
 				Math::Vector3f delta = m_center-particle.m_position ;
 				float deltaNorm = delta.norm() ;
@@ -146,6 +362,36 @@ namespace Animation
 				}
 				return Math::Vector3f(0.f) ;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void AttractionForce::operator() (const MassBatch & masses, const ForceBatch & forces) const
+			///
+			/// \brief	Batch computation of the force. normalized(delta)*(|delta|/extent) is delta/extent, the
+			/// 		loop is branch free (the test on the extent is a selection).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void operator() (const MassBatch & masses, const ForceBatch & forces) const
+			{
+				const float cx = m_center[0], cy = m_center[1], cz = m_center[2] ;
+				const float extent2 = m_extent*m_extent ;
+				const float scale = m_attractionForce/m_extent ;
+				const float * px = masses.m_position[0] ;
+				const float * py = masses.m_position[1] ;
+				const float * pz = masses.m_position[2] ;
+				float * fx = forces.m_force[0] ;
+				float * fy = forces.m_force[1] ;
+				float * fz = forces.m_force[2] ;
+				for(size_t cpt=0 ; cpt<masses.m_size ; ++cpt)
+				{
+					float dx = cx-px[cpt], dy = cy-py[cpt], dz = cz-pz[cpt] ;
+					float factor = (dx*dx+dy*dy+dz*dz<extent2) ? scale : 0.0f ;
+					fx[cpt] = dx*factor ;
+					fy[cpt] = dy*factor ;
+					fz[cpt] = dz*factor ;
+				}
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +438,37 @@ namespace Animation
 				Math::Vector3f deltaPosition = mass2.m_position - mass1.m_position ;
 				return deltaPosition*(m_stiffness*(1.0f-length/deltaPosition.norm())) ;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void SpringForce::operator() (const MassBatch & masses1, const MassBatch & masses2, const float * lengths, const ForceBatch & forces) const
+			///
+			/// \brief	Batch computation of the forces applied on masses1 by the springs linking masses1[i]
+			/// 		and masses2[i] with rest length lengths[i].
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void operator() (const MassBatch & masses1, const MassBatch & masses2, const float * lengths, const ForceBatch & forces) const
+			{
+				const float stiffness = m_stiffness ;
+				const float * x1 = masses1.m_position[0] ;
+				const float * y1 = masses1.m_position[1] ;
+				const float * z1 = masses1.m_position[2] ;
+				const float * x2 = masses2.m_position[0] ;
+				const float * y2 = masses2.m_position[1] ;
+				const float * z2 = masses2.m_position[2] ;
+				float * fx = forces.m_force[0] ;
+				float * fy = forces.m_force[1] ;
+				float * fz = forces.m_force[2] ;
+				for(size_t cpt=0 ; cpt<masses1.m_size ; ++cpt)
+				{
+					float dx = x2[cpt]-x1[cpt], dy = y2[cpt]-y1[cpt], dz = z2[cpt]-z1[cpt] ;
+					float factor = stiffness*(1.0f-lengths[cpt]/::std::sqrt(dx*dx+dy*dy+dz*dz)) ;
+					fx[cpt] = dx*factor ;
+					fy[cpt] = dy*factor ;
+					fz[cpt] = dz*factor ;
+				}
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
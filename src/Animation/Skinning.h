@@ -0,0 +1,546 @@
+#ifndef _Animation_Skinning_H
+#define _Animation_Skinning_H
+
+#include <HelperGl/LoaderOgre3D.h>
+#include <HelperGl/Mesh.h>
+#include <Math/Quaternion.h>
+#include <Math/Vectorf.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cassert>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	BonePose
+	///
+	/// \brief	The pose of a bone relative to its bind pose (as in the animations of Ogre): the local
+	/// 		rotation is the bind rotation followed by m_rotation, the local position is the bind
+	/// 		position plus m_translation. The default pose is the bind pose.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class BonePose
+	{
+	public:
+		/// \brief	The rotation (unit quaternion).
+		Math::Quaternion<float> m_rotation ;
+		/// \brief	The translation.
+		Math::Vector3f m_translation ;
+
+		BonePose()
+			: m_rotation(1.0f, Math::makeVector(0.0f, 0.0f, 0.0f)), m_translation(Math::makeVector(0.0f, 0.0f, 0.0f))
+		{}
+
+		BonePose(const Math::Quaternion<float> & rotation, const Math::Vector3f & translation)
+			: m_rotation(rotation), m_translation(translation)
+		{}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Skinning
+	///
+	/// \brief	Deformation of a mesh by a skeleton of LoaderOgre3D, on the CPU. Each vertex keeps its
+	/// 		four most influent bones (indexes and weights renormalized, packed in 24 bytes), the
+	/// 		vertices without bone follow an additional identity entry of the palette. The rest pose is
+	/// 		stored as separate x, y, z arrays.
+	///
+	/// 		The skinning data is read only once built: one Skinning can be shared by many characters,
+	/// 		each one owning its Palette. computePalette computes the palette from the poses of the
+	/// 		bones in one pass over the bones sorted parents first, deform blends the palette entries
+	/// 		of each vertex (linear blend of the 3x4 matrices or blend of the dual quaternions) on the
+	/// 		TBB worker threads by blocks of vertices. The blends are written as fixed size loops
+	/// 		over contiguous floats so that the compiler vectorizes them.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Skinning
+	{
+	public:
+		/// \brief	The skinning methods.
+		enum Method { linearBlend, dualQuaternion } ;
+
+		/// \brief	The maximum number of bones per vertex.
+		static const int influences = 4 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	Influence
+		///
+		/// \brief	The bones influencing a vertex (palette entries, weights summing to 1).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Influence
+		{
+			::std::uint16_t m_bones[influences] ;
+			float m_weights[influences] ;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Palette
+		///
+		/// \brief	The transformations from the bind pose to the current pose of each bone, as 3x4 row
+		/// 		major matrices and as dual quaternions (w, x, y, z of the real part then of the dual
+		/// 		part). The last entry is the identity.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Palette
+		{
+		public:
+			/// \brief	12 floats per entry.
+			::std::vector<float> m_matrices ;
+			/// \brief	8 floats per entry.
+			::std::vector<float> m_dualQuaternions ;
+			/// \brief	The global rotation of each bone (current pose).
+			::std::vector<Math::Quaternion<float> > m_rotations ;
+			/// \brief	The global position of each bone (current pose).
+			::std::vector<Math::Vector3f> m_positions ;
+		};
+
+	protected:
+		/// \brief	The bones sorted parents first.
+		::std::vector<int> m_order ;
+		/// \brief	The parent of each bone (-1 for the roots).
+		::std::vector<int> m_parents ;
+		/// \brief	The bind rotation of each bone relative to its parent.
+		::std::vector<Math::Quaternion<float> > m_bindRotations ;
+		/// \brief	The bind position of each bone relative to its parent.
+		::std::vector<Math::Vector3f> m_bindPositions ;
+		/// \brief	The inverse of the global bind rotation of each bone.
+		::std::vector<Math::Quaternion<float> > m_inverseBindRotations ;
+		/// \brief	The global bind position of each bone.
+		::std::vector<Math::Vector3f> m_globalBindPositions ;
+		/// \brief	The influences of each vertex.
+		::std::vector<Influence> m_influences ;
+		/// \brief	The rest positions (x, y and z arrays).
+		::std::vector<float> m_restPositions[3] ;
+		/// \brief	The rest normals (x, y and z arrays).
+		::std::vector<float> m_restNormals[3] ;
+		/// \brief	The number of vertices per task.
+		size_t m_grainSize ;
+
+		static Math::Quaternion<float> identity()
+		{
+			return Math::Quaternion<float>(1.0f, Math::makeVector(0.0f, 0.0f, 0.0f)) ;
+		}
+
+		/// \brief	Rotates v by the unit quaternion (w, x, y, z): v + 2 r x (r x v + w v).
+		static void rotate(const float * q, const float * v, float * result)
+		{
+			float c[3] = { q[2]*v[2]-q[3]*v[1]+q[0]*v[0], q[3]*v[0]-q[1]*v[2]+q[0]*v[1], q[1]*v[1]-q[2]*v[0]+q[0]*v[2] } ;
+			result[0] = v[0]+2.0f*(q[2]*c[2]-q[3]*c[1]) ;
+			result[1] = v[1]+2.0f*(q[3]*c[0]-q[1]*c[2]) ;
+			result[2] = v[2]+2.0f*(q[1]*c[1]-q[2]*c[0]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Skinning::writeEntry(const Math::Quaternion<float> & rotation,
+		/// 	const Math::Vector3f & translation, float * matrix, float * dualQuaternion)
+		///
+		/// \brief	Writes the palette entry of the rigid transformation x -> rotation(x) + translation.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void writeEntry(const Math::Quaternion<float> & rotation, const Math::Vector3f & translation, float * matrix, float * dualQuaternion)
+		{
+			float w = rotation.s(), x = rotation.v()[0], y = rotation.v()[1], z = rotation.v()[2] ;
+			float m[12] = {
+				1.0f-2.0f*(y*y+z*z), 2.0f*(x*y-w*z), 2.0f*(x*z+w*y), translation[0],
+				2.0f*(x*y+w*z), 1.0f-2.0f*(x*x+z*z), 2.0f*(y*z-w*x), translation[1],
+				2.0f*(x*z-w*y), 2.0f*(y*z+w*x), 1.0f-2.0f*(x*x+y*y), translation[2] } ;
+			::std::copy(m, m+12, matrix) ;
+			// Dual part: (0, translation) * rotation / 2
+			float tx = translation[0], ty = translation[1], tz = translation[2] ;
+			float dq[8] = { w, x, y, z,
+				-0.5f*(tx*x+ty*y+tz*z), 0.5f*(tx*w+ty*z-tz*y), 0.5f*(ty*w+tz*x-tx*z), 0.5f*(tz*w+tx*y-ty*x) } ;
+			::std::copy(dq, dq+8, dualQuaternion) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Skinning::deformLinearBlend(const Palette & palette, size_t begin, size_t end,
+		/// 	float * positions, float * normals) const
+		///
+		/// \brief	Linear blend skinning of the vertices [begin, end) (3 floats per vertex in the outputs,
+		/// 		normals may be null).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void deformLinearBlend(const Palette & palette, size_t begin, size_t end, float * positions, float * normals) const
+		{
+			const float * matrices = palette.m_matrices.data() ;
+			for(size_t vertex=begin ; vertex<end ; ++vertex)
+			{
+				const Influence & influence = m_influences[vertex] ;
+				const float * m0 = matrices+12*influence.m_bones[0] ;
+				const float * m1 = matrices+12*influence.m_bones[1] ;
+				const float * m2 = matrices+12*influence.m_bones[2] ;
+				const float * m3 = matrices+12*influence.m_bones[3] ;
+				const float w0 = influence.m_weights[0], w1 = influence.m_weights[1], w2 = influence.m_weights[2], w3 = influence.m_weights[3] ;
+				float m[12] ;
+				for(int cpt=0 ; cpt<12 ; ++cpt) { m[cpt] = w0*m0[cpt]+w1*m1[cpt]+w2*m2[cpt]+w3*m3[cpt] ; }
+				const float x = m_restPositions[0][vertex], y = m_restPositions[1][vertex], z = m_restPositions[2][vertex] ;
+				float * position = positions+3*vertex ;
+				position[0] = m[0]*x+m[1]*y+m[2]*z+m[3] ;
+				position[1] = m[4]*x+m[5]*y+m[6]*z+m[7] ;
+				position[2] = m[8]*x+m[9]*y+m[10]*z+m[11] ;
+				if(normals==NULL) { continue ; }
+				const float nx = m_restNormals[0][vertex], ny = m_restNormals[1][vertex], nz = m_restNormals[2][vertex] ;
+				float n[3] = { m[0]*nx+m[1]*ny+m[2]*nz, m[4]*nx+m[5]*ny+m[6]*nz, m[8]*nx+m[9]*ny+m[10]*nz } ;
+				float norm2 = n[0]*n[0]+n[1]*n[1]+n[2]*n[2] ;
+				float scale = (norm2>0.0f) ? 1.0f/::std::sqrt(norm2) : 0.0f ;
+				float * normal = normals+3*vertex ;
+				normal[0] = n[0]*scale ;
+				normal[1] = n[1]*scale ;
+				normal[2] = n[2]*scale ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Skinning::deformDualQuaternion(const Palette & palette, size_t begin, size_t end,
+		/// 	float * positions, float * normals) const
+		///
+		/// \brief	Dual quaternion skinning of the vertices [begin, end) (3 floats per vertex in the
+		/// 		outputs, normals may be null). The dual quaternions are flipped in the hemisphere of the
+		/// 		first one before blending.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void deformDualQuaternion(const Palette & palette, size_t begin, size_t end, float * positions, float * normals) const
+		{
+			const float * dualQuaternions = palette.m_dualQuaternions.data() ;
+			for(size_t vertex=begin ; vertex<end ; ++vertex)
+			{
+				const Influence & influence = m_influences[vertex] ;
+				const float * q0 = dualQuaternions+8*influence.m_bones[0] ;
+				const float * q1 = dualQuaternions+8*influence.m_bones[1] ;
+				const float * q2 = dualQuaternions+8*influence.m_bones[2] ;
+				const float * q3 = dualQuaternions+8*influence.m_bones[3] ;
+				const float w0 = influence.m_weights[0] ;
+				const float w1 = (q0[0]*q1[0]+q0[1]*q1[1]+q0[2]*q1[2]+q0[3]*q1[3]<0.0f) ? -influence.m_weights[1] : influence.m_weights[1] ;
+				const float w2 = (q0[0]*q2[0]+q0[1]*q2[1]+q0[2]*q2[2]+q0[3]*q2[3]<0.0f) ? -influence.m_weights[2] : influence.m_weights[2] ;
+				const float w3 = (q0[0]*q3[0]+q0[1]*q3[1]+q0[2]*q3[2]+q0[3]*q3[3]<0.0f) ? -influence.m_weights[3] : influence.m_weights[3] ;
+				float q[8] ;
+				for(int cpt=0 ; cpt<8 ; ++cpt) { q[cpt] = w0*q0[cpt]+w1*q1[cpt]+w2*q2[cpt]+w3*q3[cpt] ; }
+				float norm = ::std::sqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3]) ;
+				float inverse = 1.0f/norm ;
+				for(int cpt=0 ; cpt<8 ; ++cpt) { q[cpt] *= inverse ; }
+				// Translation: 2 * vector part of dual * conjugate(real)
+				float t[3] = {
+					2.0f*(q[0]*q[5]-q[4]*q[1]+q[2]*q[7]-q[3]*q[6]),
+					2.0f*(q[0]*q[6]-q[4]*q[2]+q[3]*q[5]-q[1]*q[7]),
+					2.0f*(q[0]*q[7]-q[4]*q[3]+q[1]*q[6]-q[2]*q[5]) } ;
+				float rest[3] = { m_restPositions[0][vertex], m_restPositions[1][vertex], m_restPositions[2][vertex] } ;
+				float * position = positions+3*vertex ;
+				rotate(q, rest, position) ;
+				position[0] += t[0] ;
+				position[1] += t[1] ;
+				position[2] += t[2] ;
+				if(normals==NULL) { continue ; }
+				float restNormal[3] = { m_restNormals[0][vertex], m_restNormals[1][vertex], m_restNormals[2][vertex] } ;
+				rotate(q, restNormal, normals+3*vertex) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Skinning::deform(const Palette & palette, Method method, float * positions,
+		/// 	float * normals) const
+		///
+		/// \brief	Deforms all the vertices on the TBB worker threads.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void deform(const Palette & palette, Method method, float * positions, float * normals) const
+		{
+			assert(palette.m_matrices.size()==12*(bones()+1)) ;
+			const Skinning & self = *this ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, vertices(), m_grainSize), [&self, &palette, method, positions, normals](const ::tbb::blocked_range<size_t> & range)
+			{
+				if(method==linearBlend) { self.deformLinearBlend(palette, range.begin(), range.end(), positions, normals) ; }
+				else { self.deformDualQuaternion(palette, range.begin(), range.end(), positions, normals) ; }
+			}) ;
+		}
+
+		template <class Vector3>
+		void setRest(const ::std::vector<Vector3> & values, ::std::vector<float> * rest)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				rest[axis].resize(values.size()) ;
+				for(size_t cpt=0 ; cpt<values.size() ; ++cpt) { rest[axis][cpt] = values[cpt][axis] ; }
+			}
+		}
+
+		template <class Vector3>
+		static void copyResult(const ::std::vector<float> & values, ::std::vector<Vector3> & result)
+		{
+			result.resize(values.size()/3) ;
+			for(size_t cpt=0 ; cpt<result.size() ; ++cpt)
+			{
+				for(int axis=0 ; axis<3 ; ++axis) { result[cpt][axis] = values[3*cpt+axis] ; }
+			}
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Skinning::Skinning(const HelperGl::LoaderOgre3D::Skeleton & skeleton,
+		/// 	const ::std::vector<HelperGl::LoaderOgre3D::BoneAssignment> & assignments,
+		/// 	size_t vertices)
+		///
+		/// \brief	Constructor. The rest pose must be provided with setRestPose before deforming.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	skeleton   	The skeleton (the bind pose is the pose of the bones).
+		/// \param	assignments	The bone assignments of the mesh (bones given by their identifier, see
+		/// 					LoaderOgre3D::loadMesh).
+		/// \param	vertices   	The number of vertices of the mesh.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Skinning(const HelperGl::LoaderOgre3D::Skeleton & skeleton, const ::std::vector<HelperGl::LoaderOgre3D::BoneAssignment> & assignments, size_t vertices)
+			: m_grainSize(1024)
+		{
+			const size_t bones = skeleton.size() ;
+			assert(bones<0xffff) ;
+			m_parents.resize(bones) ;
+			m_bindRotations.resize(bones) ;
+			m_bindPositions.resize(bones) ;
+			for(size_t bone=0 ; bone<bones ; ++bone)
+			{
+				const HelperGl::LoaderOgre3D::Skeleton::Bone & current = skeleton.bone(bone) ;
+				m_parents[bone] = skeleton.parentIndex(bone) ;
+				m_bindPositions[bone] = current.m_position ;
+				m_bindRotations[bone] = (current.m_rotationAxis.norm()>0.0f) ? Math::Quaternion<float>(current.m_rotationAxis.normalized(), current.m_rotationAngle) : identity() ;
+			}
+			// Parents first: breadth first traversal from the roots
+			::std::vector<::std::vector<int> > sons(bones) ;
+			for(size_t bone=0 ; bone<bones ; ++bone)
+			{
+				if(m_parents[bone]<0) { m_order.push_back(int(bone)) ; }
+				else { sons[m_parents[bone]].push_back(int(bone)) ; }
+			}
+			for(size_t cpt=0 ; cpt<m_order.size() ; ++cpt)
+			{
+				const ::std::vector<int> & current = sons[m_order[cpt]] ;
+				m_order.insert(m_order.end(), current.begin(), current.end()) ;
+			}
+			assert(m_order.size()==bones) ;
+			// Global bind pose
+			Palette bind ;
+			computePalette(NULL, bind) ;
+			m_inverseBindRotations.resize(bones) ;
+			m_globalBindPositions = bind.m_positions ;
+			for(size_t bone=0 ; bone<bones ; ++bone) { m_inverseBindRotations[bone] = bind.m_rotations[bone].inv() ; }
+			// The four most influent bones of each vertex
+			::std::vector<::std::vector<::std::pair<float, int> > > weights(vertices) ;
+			for(auto it=assignments.begin(), end=assignments.end() ; it!=end ; ++it)
+			{
+				int bone = skeleton.indexOf(::std::to_string(it->m_bone)) ;
+				if(bone<0 || it->m_vertex>=vertices || it->m_weight<=0.0f) { continue ; }
+				weights[it->m_vertex].push_back(::std::make_pair(it->m_weight, bone)) ;
+			}
+			m_influences.resize(vertices) ;
+			for(size_t vertex=0 ; vertex<vertices ; ++vertex)
+			{
+				::std::vector<::std::pair<float, int> > & current = weights[vertex] ;
+				::std::sort(current.begin(), current.end(), [](const ::std::pair<float, int> & a, const ::std::pair<float, int> & b) { return a.first>b.first ; }) ;
+				size_t count = ::std::min<size_t>(current.size(), influences) ;
+				float sum = 0.0f ;
+				for(size_t cpt=0 ; cpt<count ; ++cpt) { sum += current[cpt].first ; }
+				Influence & influence = m_influences[vertex] ;
+				for(size_t cpt=0 ; cpt<size_t(influences) ; ++cpt)
+				{
+					// Unused slots point to the first bone with a null weight
+					influence.m_bones[cpt] = ::std::uint16_t((cpt<count) ? current[cpt].second : (count>0 ? current[0].second : bones)) ;
+					influence.m_weights[cpt] = (cpt<count) ? current[cpt].first/sum : 0.0f ;
+				}
+				// No bone: the vertex follows the identity
+				if(count==0) { influence.m_weights[0] = 1.0f ; }
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Skinning::Skinning(const HelperGl::LoaderOgre3D::Skeleton & skeleton,
+		/// 	const HelperGl::LoaderOgre3D::Mesh & mesh)
+		///
+		/// \brief	Constructor from a sub mesh loaded by LoaderOgre3D::loadMesh: the bone assignments
+		/// 		and the rest pose are those of the mesh.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	skeleton	The skeleton loaded by LoaderOgre3D::loadSkeleton.
+		/// \param	mesh		The sub mesh.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Skinning(const HelperGl::LoaderOgre3D::Skeleton & skeleton, const HelperGl::LoaderOgre3D::Mesh & mesh)
+			: Skinning(skeleton, mesh.m_boneAssignments, mesh.m_positions.size())
+		{
+			setRestPose(mesh.m_positions, mesh.m_normals) ;
+		}
+
+		size_t bones() const
+		{
+			return m_parents.size() ;
+		}
+
+		size_t vertices() const
+		{
+			return m_influences.size() ;
+		}
+
+		const Influence & influence(size_t vertex) const
+		{
+			return m_influences[vertex] ;
+		}
+
+		/// \brief	Sets the number of vertices per task.
+		void setGrainSize(size_t grainSize)
+		{
+			m_grainSize = ::std::max<size_t>(grainSize, 1) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Vector3> void Skinning::setRestPose(const ::std::vector<Vector3> & positions,
+		/// 	const ::std::vector<Vector3> & normals)
+		///
+		/// \brief	Sets the positions and normals of the vertices in the bind pose.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Vector3	Math::Vector3f or glm::vec3 (any type with operator[]).
+		/// \param	positions	The positions (vertices() values).
+		/// \param	normals  	The normals (vertices() values or empty).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Vector3>
+		void setRestPose(const ::std::vector<Vector3> & positions, const ::std::vector<Vector3> & normals)
+		{
+			assert(positions.size()==vertices()) ;
+			assert(normals.empty() || normals.size()==vertices()) ;
+			setRest(positions, m_restPositions) ;
+			setRest(normals, m_restNormals) ;
+		}
+
+		/// \brief	Sets the rest pose from a mesh.
+		void setRestPose(const HelperGl::Mesh & mesh)
+		{
+			setRestPose(mesh.getVertices(), mesh.getVerticesNormals()) ;
+		}
+
+		/// \brief	Creates a palette for this skeleton (initialized to the bind pose).
+		Palette createPalette() const
+		{
+			Palette palette ;
+			computePalette(NULL, palette) ;
+			return palette ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Skinning::computePalette(const BonePose * pose, Palette & palette) const
+		///
+		/// \brief	Computes the global transformations of the bones and the palette in one pass over the
+		/// 		bones (parents first).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param 		 	pose   	The pose of each bone relative to its bind pose (bones() values), the
+		/// 						bind pose if null.
+		/// \param [in,out]	palette	The palette.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computePalette(const BonePose * pose, Palette & palette) const
+		{
+			const size_t bones = this->bones() ;
+			palette.m_rotations.resize(bones) ;
+			palette.m_positions.resize(bones) ;
+			palette.m_matrices.resize(12*(bones+1)) ;
+			palette.m_dualQuaternions.resize(8*(bones+1)) ;
+			const bool hasInverseBind = m_inverseBindRotations.size()==bones ;
+			for(auto it=m_order.begin(), end=m_order.end() ; it!=end ; ++it)
+			{
+				const int bone = *it ;
+				Math::Quaternion<float> rotation = m_bindRotations[bone] ;
+				Math::Vector3f position = m_bindPositions[bone] ;
+				if(pose!=NULL)
+				{
+					rotation = (rotation*pose[bone].m_rotation).normalize() ;
+					position = position+pose[bone].m_translation ;
+				}
+				const int parent = m_parents[bone] ;
+				if(parent>=0)
+				{
+					position = palette.m_positions[parent]+palette.m_rotations[parent].rotate(position) ;
+					rotation = palette.m_rotations[parent]*rotation ;
+				}
+				palette.m_rotations[bone] = rotation ;
+				palette.m_positions[bone] = position ;
+				if(!hasInverseBind) { continue ; }
+				// Current global transformation * inverse of the global bind transformation
+				Math::Quaternion<float> skin = rotation*m_inverseBindRotations[bone] ;
+				Math::Vector3f translation = position-skin.rotate(m_globalBindPositions[bone]) ;
+				writeEntry(skin, translation, palette.m_matrices.data()+12*bone, palette.m_dualQuaternions.data()+8*bone) ;
+			}
+			writeEntry(identity(), Math::makeVector(0.0f, 0.0f, 0.0f), palette.m_matrices.data()+12*bones, palette.m_dualQuaternions.data()+8*bones) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Vector3> void Skinning::deform(const Palette & palette, Method method,
+		/// 	::std::vector<Vector3> & positions, ::std::vector<Vector3> & normals) const
+		///
+		/// \brief	Deforms the rest pose. With gl3::Mesh, use glm::vec3 vectors and give them to
+		/// 		setVertices / setNormals.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Vector3	Math::Vector3f or glm::vec3 (any type with operator[]).
+		/// \param 		 	palette  	The palette.
+		/// \param 		 	method   	The skinning method.
+		/// \param [in,out]	positions	The deformed positions.
+		/// \param [in,out]	normals  	The deformed normals (left empty without rest normals).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Vector3>
+		void deform(const Palette & palette, Method method, ::std::vector<Vector3> & positions, ::std::vector<Vector3> & normals) const
+		{
+			const bool hasNormals = !m_restNormals[0].empty() ;
+			// Tightly packed 3 floats vectors are written in place
+			if(sizeof(Vector3)==3*sizeof(float))
+			{
+				positions.resize(vertices()) ;
+				normals.resize(hasNormals ? vertices() : 0) ;
+				deform(palette, method, reinterpret_cast<float*>(positions.data()), hasNormals ? reinterpret_cast<float*>(normals.data()) : NULL) ;
+				return ;
+			}
+			::std::vector<float> deformedPositions(3*vertices()) ;
+			::std::vector<float> deformedNormals(hasNormals ? 3*vertices() : 0) ;
+			deform(palette, method, deformedPositions.data(), hasNormals ? deformedNormals.data() : NULL) ;
+			copyResult(deformedPositions, positions) ;
+			copyResult(deformedNormals, normals) ;
+		}
+
+		/// \brief	Deforms the vertices and normals of a mesh.
+		void deform(const Palette & palette, Method method, HelperGl::Mesh & mesh) const
+		{
+			::std::vector<Math::Vector3f> positions ;
+			::std::vector<Math::Vector3f> normals ;
+			deform(palette, method, positions, normals) ;
+			mesh.setVertices(positions) ;
+			if(!normals.empty()) { mesh.setVerticesNormals(normals) ; }
+		}
+	};
+}
+
+#endif
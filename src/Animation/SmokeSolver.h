@@ -0,0 +1,956 @@
+#ifndef _Animation_SmokeSolver_H
+#define _Animation_SmokeSolver_H
+
+#include <Animation/ParticleSystem.h>
+#include <Animation/PonctualMass.h>
+#include <Math/Vectorf.h>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/combinable.h>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	SmokeSolver
+	///
+	/// \brief	Eulerian smoke / fire solver (stable fluids, Stam 1999, with the buoyancy and the
+	/// 		vorticity confinement of Fedkiw et al. 2001). Velocity, density and temperature are
+	/// 		stored at the centers of the cells of a regular grid (x varies first). An update:
+	/// 		1 - applies the sources, 2 - advects all the fields (semi-Lagrangian, midpoint back
+	/// 		tracing, trilinear interpolation), 3 - applies the buoyancy and the vorticity
+	/// 		confinement, 4 - projects the velocity on divergence free fields. The Poisson equation
+	/// 		of the projection is solved by a conjugate gradient preconditioned by a multigrid
+	/// 		V-cycle (damped Jacobi smoothing, the pressure of the previous update is the initial
+	/// 		guess). As in Stam's stable fluids, the projection uses the compact Laplacian on the
+	/// 		collocated grid, it is approximate (the divergence is reduced, not cancelled). The
+	/// 		boundaries of the domain are open (zero pressure). All passes run in
+	/// 		parallel by slabs (one z index per task) and their inner loops run along x on
+	/// 		contiguous arrays. Particles can be advected by the velocity field (see attach).
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class SmokeSolver
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Source
+		///
+		/// \brief	A spherical source of smoke.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Source
+		{
+		public:
+			/// \brief	The center of the source.
+			Math::Vector3f m_center ;
+			/// \brief	The radius of the source.
+			float m_radius ;
+			/// \brief	The density added per second.
+			float m_density ;
+			/// \brief	The temperature added per second.
+			float m_temperature ;
+			/// \brief	The inflow velocity (the velocity of the covered cells is set to this value if not null).
+			Math::Vector3f m_velocity ;
+		};
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	GridLevel
+		///
+		/// \brief	A level of the multigrid hierarchy.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class GridLevel
+		{
+		public:
+			/// \brief	The number of cells on each axis.
+			int m_resolution[3] ;
+			/// \brief	The solution (unused on the finest level).
+			::std::vector<float> m_solution ;
+			/// \brief	The right hand side (unused on the finest level).
+			::std::vector<float> m_rhs ;
+			/// \brief	The residual.
+			::std::vector<float> m_residual ;
+
+			GridLevel(int x, int y, int z)
+			{
+				m_resolution[0] = x ; m_resolution[1] = y ; m_resolution[2] = z ;
+			}
+
+			size_t size() const
+			{
+				return (size_t)m_resolution[0]*m_resolution[1]*m_resolution[2] ;
+			}
+		};
+
+		/// \brief	Damping of the Jacobi iterations.
+		static float jacobiWeight() { return 6.0f/7.0f ; }
+		enum { smoothingIterations = 2, coarsestIterations = 32 } ;
+
+		/// \brief	The lower corner of the domain.
+		Math::Vector3f m_min ;
+		/// \brief	The size of the cells.
+		float m_cellSize ;
+		/// \brief	The number of cells on each axis.
+		int m_resolution[3] ;
+
+		/// \brief	The velocity (one array per component).
+		::std::vector<float> m_velocity[3] ;
+		/// \brief	The density of the smoke.
+		::std::vector<float> m_density ;
+		/// \brief	The temperature of the smoke (relative to the ambient temperature).
+		::std::vector<float> m_temperature ;
+		/// \brief	Advection buffers (velocity, density and temperature), also used for the vorticity.
+		::std::vector<float> m_buffers[5] ;
+
+		/// \brief	The pressure (kept between updates as the initial guess of the solver).
+		::std::vector<float> m_pressure ;
+		/// \brief	Conjugate gradient vectors: right hand side, residual, preconditioned residual,
+		/// 		direction and product of the operator with the direction.
+		::std::vector<float> m_rhs, m_residual, m_preconditioned, m_direction, m_product ;
+		/// \brief	The multigrid hierarchy (the finest level has the resolution of the grid).
+		::std::vector<GridLevel> m_levels ;
+		/// \brief	A row of zeros (neighbors outside of the grid).
+		::std::vector<float> m_zeroRow ;
+
+		/// \brief	The sources.
+		::std::vector<Source> m_sources ;
+		/// \brief	The up direction (buoyancy direction).
+		Math::Vector3f m_up ;
+		/// \brief	Weight of the density in the buoyancy (smoke sinks).
+		float m_densityBuoyancy ;
+		/// \brief	Weight of the temperature in the buoyancy (hot smoke rises).
+		float m_temperatureBuoyancy ;
+		/// \brief	The vorticity confinement strength.
+		float m_vorticityConfinement ;
+		/// \brief	Dissipation rate of the density (per second).
+		float m_densityDissipation ;
+		/// \brief	Dissipation rate of the temperature (per second).
+		float m_temperatureDissipation ;
+		/// \brief	Relative tolerance of the pressure solve.
+		float m_tolerance ;
+		/// \brief	Maximum number of conjugate gradient iterations.
+		int m_maxIterations ;
+		/// \brief	Number of iterations of the last pressure solve.
+		int m_lastIterations ;
+		/// \brief	Drag coefficient of the particles advected by the smoke.
+		float m_drag ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Function> static void SmokeSolver::forEachSlab(int slabs, const Function & function)
+		///
+		/// \brief	Calls function(z) for each z in [0;slabs), in parallel.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Function>
+		static void forEachSlab(int slabs, const Function & function)
+		{
+			::tbb::parallel_for(::tbb::blocked_range<int>(0, slabs), [&function](const ::tbb::blocked_range<int> & range)
+			{
+				for(int z=range.begin() ; z!=range.end() ; ++z) { function(z) ; }
+			}) ;
+		}
+
+		size_t cellIndex(int x, int y, int z) const
+		{
+			return ((size_t)z*m_resolution[1]+y)*m_resolution[0]+x ;
+		}
+
+		size_t size() const
+		{
+			return (size_t)m_resolution[0]*m_resolution[1]*m_resolution[2] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Stencil
+		///
+		/// \brief	Trilinear interpolation stencil of a position in a cell centered grid.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Stencil
+		{
+		public:
+			/// \brief	Index of the lower cell.
+			size_t m_index ;
+			/// \brief	Offsets of the next cell on each axis (strides of the grid).
+			size_t m_offset[3] ;
+			/// \brief	Interpolation weights on each axis.
+			float m_weight[3] ;
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Stencil::Stencil(const int resolution[3], float x, float y, float z)
+			///
+			/// \brief	Constructor, (x, y, z) is a position in cell units (the center of cell i is i).
+			/// 		Positions outside of the grid are clamped.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Stencil(const int resolution[3], float x, float y, float z)
+			{
+				const float position[3] = { x, y, z } ;
+				int cell[3] ;
+				size_t stride = 1 ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					float p = ::std::min(::std::max(position[axis], 0.0f), float(resolution[axis]-1)) ;
+					cell[axis] = ::std::min((int)p, resolution[axis]-2) ;
+					m_weight[axis] = p-float(cell[axis]) ;
+					m_offset[axis] = stride ;
+					stride *= resolution[axis] ;
+				}
+				m_index = ((size_t)cell[2]*resolution[1]+cell[1])*resolution[0]+cell[0] ;
+			}
+
+			float operator() (const float * field) const
+			{
+				const float * base = field+m_index ;
+				const size_t dx = m_offset[0], dy = m_offset[1], dz = m_offset[2] ;
+				float v00 = base[0]+(base[dx]-base[0])*m_weight[0] ;
+				float v10 = base[dy]+(base[dy+dx]-base[dy])*m_weight[0] ;
+				float v01 = base[dz]+(base[dz+dx]-base[dz])*m_weight[0] ;
+				float v11 = base[dz+dy]+(base[dz+dy+dx]-base[dz+dy])*m_weight[0] ;
+				float v0 = v00+(v10-v00)*m_weight[1] ;
+				float v1 = v01+(v11-v01)*m_weight[1] ;
+				return v0+(v1-v0)*m_weight[2] ;
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Stencil SmokeSolver::stencil(const Math::Vector3f & position) const
+		///
+		/// \brief	Gets the interpolation stencil of a position in world coordinates.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Stencil stencil(const Math::Vector3f & position) const
+		{
+			const float inverse = 1.0f/m_cellSize ;
+			return Stencil(m_resolution, (position[0]-m_min[0])*inverse-0.5f, (position[1]-m_min[1])*inverse-0.5f, (position[2]-m_min[2])*inverse-0.5f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::applySources(float dt)
+		///
+		/// \brief	Applies the sources.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void applySources(float dt)
+		{
+			for(const Source & source : m_sources)
+			{
+				int lower[3], upper[3] ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					lower[axis] = ::std::max((int)::std::floor((source.m_center[axis]-source.m_radius-m_min[axis])/m_cellSize), 0) ;
+					upper[axis] = ::std::min((int)::std::ceil((source.m_center[axis]+source.m_radius-m_min[axis])/m_cellSize), m_resolution[axis]) ;
+				}
+				const bool inflow = source.m_velocity.norm2()>0.0f ;
+				const float radius2 = source.m_radius*source.m_radius ;
+				for(int z=lower[2] ; z<upper[2] ; ++z)
+				{
+					for(int y=lower[1] ; y<upper[1] ; ++y)
+					{
+						for(int x=lower[0] ; x<upper[0] ; ++x)
+						{
+							Math::Vector3f delta = cellCenter(x, y, z)-source.m_center ;
+							if(delta.norm2()>radius2) { continue ; }
+							size_t index = cellIndex(x, y, z) ;
+							m_density[index] += source.m_density*dt ;
+							m_temperature[index] += source.m_temperature*dt ;
+							if(inflow)
+							{
+								for(int axis=0 ; axis<3 ; ++axis) { m_velocity[axis][index] = source.m_velocity[axis] ; }
+							}
+						}
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::advect(float dt)
+		///
+		/// \brief	Semi-Lagrangian advection of the velocity, the density and the temperature. The
+		/// 		position of each cell center is traced back with the midpoint method, the five fields
+		/// 		are interpolated with the same stencil. The dissipation is applied to the scalars.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void advect(float dt)
+		{
+			const int nx = m_resolution[0], ny = m_resolution[1] ;
+			const int * resolution = m_resolution ;
+			const float * u = m_velocity[0].data() ;
+			const float * v = m_velocity[1].data() ;
+			const float * w = m_velocity[2].data() ;
+			const float * density = m_density.data() ;
+			const float * temperature = m_temperature.data() ;
+			float * outU = m_buffers[0].data() ;
+			float * outV = m_buffers[1].data() ;
+			float * outW = m_buffers[2].data() ;
+			float * outDensity = m_buffers[3].data() ;
+			float * outTemperature = m_buffers[4].data() ;
+			const float scale = dt/m_cellSize ; // World velocity to cells per step
+			const float densityFactor = 1.0f/(1.0f+dt*m_densityDissipation) ;
+			const float temperatureFactor = 1.0f/(1.0f+dt*m_temperatureDissipation) ;
+			forEachSlab(m_resolution[2], [=](int z)
+			{
+				for(int y=0 ; y<ny ; ++y)
+				{
+					size_t index = ((size_t)z*ny+y)*nx ;
+					for(int x=0 ; x<nx ; ++x, ++index)
+					{
+						// Midpoint
+						float mx = float(x)-0.5f*scale*u[index] ;
+						float my = float(y)-0.5f*scale*v[index] ;
+						float mz = float(z)-0.5f*scale*w[index] ;
+						Stencil middle(resolution, mx, my, mz) ;
+						// Back traced position
+						Stencil back(resolution, float(x)-scale*middle(u), float(y)-scale*middle(v), float(z)-scale*middle(w)) ;
+						outU[index] = back(u) ;
+						outV[index] = back(v) ;
+						outW[index] = back(w) ;
+						outDensity[index] = back(density)*densityFactor ;
+						outTemperature[index] = back(temperature)*temperatureFactor ;
+					}
+				}
+			}) ;
+			for(int axis=0 ; axis<3 ; ++axis) { m_velocity[axis].swap(m_buffers[axis]) ; }
+			m_density.swap(m_buffers[3]) ;
+			m_temperature.swap(m_buffers[4]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::applyForces(float dt)
+		///
+		/// \brief	Applies the buoyancy and the vorticity confinement. The vorticity (curl of the
+		/// 		velocity, central differences) and its norm are computed in a first pass, the
+		/// 		confinement force eps * h * (N x vorticity) with N the normalized gradient of the
+		/// 		norm of the vorticity is applied in a second pass.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void applyForces(float dt)
+		{
+			const int nx = m_resolution[0], ny = m_resolution[1], nz = m_resolution[2] ;
+			const size_t sliceSize = (size_t)nx*ny ;
+			float * u = m_velocity[0].data() ;
+			float * v = m_velocity[1].data() ;
+			float * w = m_velocity[2].data() ;
+			const float * density = m_density.data() ;
+			const float * temperature = m_temperature.data() ;
+			float * vorticity[3] = { m_buffers[0].data(), m_buffers[1].data(), m_buffers[2].data() } ;
+			float * vorticityNorm = m_buffers[3].data() ;
+			const float confinement = m_vorticityConfinement ;
+			const float inverse2h = 0.5f/m_cellSize ;
+			if(confinement>0.0f)
+			{
+				forEachSlab(nz, [=, &vorticity](int z)
+				{
+					const size_t zm = (z>0) ? sliceSize : 0, zp = (z<nz-1) ? sliceSize : 0 ;
+					for(int y=0 ; y<ny ; ++y)
+					{
+						const size_t ym = (y>0) ? nx : 0, yp = (y<ny-1) ? nx : 0 ;
+						size_t index = ((size_t)z*ny+y)*nx ;
+						for(int x=0 ; x<nx ; ++x, ++index)
+						{
+							const size_t xm = (x>0), xp = (x<nx-1) ;
+							float wx = (w[index+yp]-w[index-ym]-v[index+zp]+v[index-zm])*inverse2h ;
+							float wy = (u[index+zp]-u[index-zm]-w[index+xp]+w[index-xm])*inverse2h ;
+							float wz = (v[index+xp]-v[index-xm]-u[index+yp]+u[index-ym])*inverse2h ;
+							vorticity[0][index] = wx ;
+							vorticity[1][index] = wy ;
+							vorticity[2][index] = wz ;
+							vorticityNorm[index] = ::std::sqrt(wx*wx+wy*wy+wz*wz) ;
+						}
+					}
+				}) ;
+			}
+			const float scale = confinement*m_cellSize*dt ;
+			const float densityBuoyancy = m_densityBuoyancy*dt ;
+			const float temperatureBuoyancy = m_temperatureBuoyancy*dt ;
+			const Math::Vector3f up = m_up ;
+			forEachSlab(nz, [=, &vorticity](int z)
+			{
+				const size_t zm = (z>0) ? sliceSize : 0, zp = (z<nz-1) ? sliceSize : 0 ;
+				for(int y=0 ; y<ny ; ++y)
+				{
+					const size_t ym = (y>0) ? nx : 0, yp = (y<ny-1) ? nx : 0 ;
+					size_t index = ((size_t)z*ny+y)*nx ;
+					for(int x=0 ; x<nx ; ++x, ++index)
+					{
+						float buoyancy = temperatureBuoyancy*temperature[index]-densityBuoyancy*density[index] ;
+						float fx = buoyancy*up[0], fy = buoyancy*up[1], fz = buoyancy*up[2] ;
+						if(confinement>0.0f)
+						{
+							const size_t xm = (x>0), xp = (x<nx-1) ;
+							float nxg = vorticityNorm[index+xp]-vorticityNorm[index-xm] ;
+							float nyg = vorticityNorm[index+yp]-vorticityNorm[index-ym] ;
+							float nzg = vorticityNorm[index+zp]-vorticityNorm[index-zm] ;
+							float inverseNorm = 1.0f/(::std::sqrt(nxg*nxg+nyg*nyg+nzg*nzg)+1e-10f) ;
+							nxg *= inverseNorm ; nyg *= inverseNorm ; nzg *= inverseNorm ;
+							const float wx = vorticity[0][index], wy = vorticity[1][index], wz = vorticity[2][index] ;
+							fx += scale*(nyg*wz-nzg*wy) ;
+							fy += scale*(nzg*wx-nxg*wz) ;
+							fz += scale*(nxg*wy-nyg*wx) ;
+						}
+						u[index] += fx ;
+						v[index] += fy ;
+						w[index] += fz ;
+					}
+				}
+			}) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class RowFunction> void SmokeSolver::laplacian(const GridLevel & level, const float * input, float * output, const RowFunction & rowFunction) const
+		///
+		/// \brief	Computes output = A input with A = 6 I - (sum of the 6 neighbors) (zero outside of the
+		/// 		grid). After each row, rowFunction(rowIndex, outputRow) is called, it can transform
+		/// 		the row while it is in the cache.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class RowFunction>
+		void laplacian(const GridLevel & level, const float * input, float * output, const RowFunction & rowFunction) const
+		{
+			const int nx = level.m_resolution[0], ny = level.m_resolution[1], nz = level.m_resolution[2] ;
+			const size_t sliceSize = (size_t)nx*ny ;
+			const float * zero = m_zeroRow.data() ;
+			forEachSlab(nz, [=, &rowFunction](int z)
+			{
+				for(int y=0 ; y<ny ; ++y)
+				{
+					const size_t row = ((size_t)z*ny+y)*nx ;
+					float * out = output+row ;
+					const float * center = input+row ;
+					const float * ym = (y>0) ? center-nx : zero ;
+					const float * yp = (y<ny-1) ? center+nx : zero ;
+					const float * zm = (z>0) ? center-sliceSize : zero ;
+					const float * zp = (z<nz-1) ? center+sliceSize : zero ;
+					for(int x=0 ; x<nx ; ++x)
+					{
+						out[x] = 6.0f*center[x]-ym[x]-yp[x]-zm[x]-zp[x] ;
+					}
+					for(int x=1 ; x<nx ; ++x) { out[x] -= center[x-1] ; }
+					for(int x=0 ; x<nx-1 ; ++x) { out[x] -= center[x+1] ; }
+					rowFunction(row, out) ;
+				}
+			}) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::smooth(const GridLevel & level, float * solution, const float * rhs, float * residual, int iterations) const
+		///
+		/// \brief	Damped Jacobi iterations.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void smooth(const GridLevel & level, float * solution, const float * rhs, float * residual, int iterations) const
+		{
+			const int nx = level.m_resolution[0] ;
+			const float weight = jacobiWeight()/6.0f ;
+			for(int iteration=0 ; iteration<iterations ; ++iteration)
+			{
+				// The update is done after the computation of the whole residual
+				laplacian(level, solution, residual, [=](size_t row, float * product)
+				{
+					for(int x=0 ; x<nx ; ++x) { product[x] = rhs[row+x]-product[x] ; }
+				}) ;
+				const int ny = level.m_resolution[1] ;
+				forEachSlab(level.m_resolution[2], [=](int z)
+				{
+					const size_t begin = (size_t)z*ny*nx, end = begin+(size_t)ny*nx ;
+					for(size_t cpt=begin ; cpt<end ; ++cpt) { solution[cpt] += weight*residual[cpt] ; }
+				}) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::vCycle(size_t levelIndex, float * solution, const float * rhs)
+		///
+		/// \brief	Multigrid V-cycle with a zero initial guess. The residual is restricted by summing the
+		/// 		8 children (scaled by 1/2: the coarse operator is the same stencil with a doubled cell
+		/// 		size), the correction is prolongated by injection. The restriction is the transpose
+		/// 		of the prolongation and the smoother is symmetric: the V-cycle is a symmetric
+		/// 		preconditioner.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void vCycle(size_t levelIndex, float * solution, const float * rhs)
+		{
+			GridLevel & level = m_levels[levelIndex] ;
+			float * residual = level.m_residual.data() ;
+			::std::fill(solution, solution+level.size(), 0.0f) ;
+			if(levelIndex+1==m_levels.size())
+			{
+				smooth(level, solution, rhs, residual, coarsestIterations) ;
+				return ;
+			}
+			const int fx = level.m_resolution[0], fy = level.m_resolution[1], fz = level.m_resolution[2] ;
+			smooth(level, solution, rhs, residual, smoothingIterations) ;
+			laplacian(level, solution, residual, [=](size_t row, float * product)
+			{
+				for(int x=0 ; x<fx ; ++x) { product[x] = rhs[row+x]-product[x] ; }
+			}) ;
+			GridLevel & coarse = m_levels[levelIndex+1] ;
+			const int cx = coarse.m_resolution[0], cy = coarse.m_resolution[1] ;
+			float * coarseRhs = coarse.m_rhs.data() ;
+			forEachSlab(coarse.m_resolution[2], [=](int z)
+			{
+				for(int y=0 ; y<cy ; ++y)
+				{
+					float * out = coarseRhs+((size_t)z*cy+y)*cx ;
+					::std::fill(out, out+cx, 0.0f) ;
+					for(int dz=0 ; dz<2 && 2*z+dz<fz ; ++dz)
+					{
+						for(int dy=0 ; dy<2 && 2*y+dy<fy ; ++dy)
+						{
+							const float * in = residual+((size_t)(2*z+dz)*fy+2*y+dy)*fx ;
+							for(int x=0 ; x<fx ; ++x) { out[x>>1] += 0.5f*in[x] ; }
+						}
+					}
+				}
+			}) ;
+			float * correction = coarse.m_solution.data() ;
+			vCycle(levelIndex+1, correction, coarseRhs) ;
+			forEachSlab(fz, [=](int z)
+			{
+				for(int y=0 ; y<fy ; ++y)
+				{
+					float * out = solution+((size_t)z*fy+y)*fx ;
+					const float * in = correction+((size_t)(z>>1)*cy+(y>>1))*cx ;
+					for(int x=0 ; x<fx ; ++x) { out[x] += in[x>>1] ; }
+				}
+			}) ;
+			smooth(level, solution, rhs, residual, smoothingIterations) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	double SmokeSolver::dot(const float * a, const float * b) const
+		///
+		/// \brief	Dot product of two fields of the grid (accumulated in double precision).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		double dot(const float * a, const float * b) const
+		{
+			const size_t sliceSize = (size_t)m_resolution[0]*m_resolution[1] ;
+			::tbb::combinable<double> sums([]() { return 0.0 ; }) ;
+			forEachSlab(m_resolution[2], [=, &sums](int z)
+			{
+				double sum = 0.0 ;
+				for(size_t cpt=z*sliceSize, end=cpt+sliceSize ; cpt<end ; ++cpt) { sum += double(a[cpt])*b[cpt] ; }
+				sums.local() += sum ;
+			}) ;
+			return sums.combine([](double a, double b) { return a+b ; }) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::project()
+		///
+		/// \brief	Projects the velocity on divergence free fields: solves A p = -h^2 div(u) (A is the
+		/// 		Laplacian scaled by -h^2) with the preconditioned conjugate gradient, then subtracts
+		/// 		the gradient of p from the velocity.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void project()
+		{
+			const int nx = m_resolution[0], ny = m_resolution[1], nz = m_resolution[2] ;
+			const size_t sliceSize = (size_t)nx*ny ;
+			float * u = m_velocity[0].data() ;
+			float * v = m_velocity[1].data() ;
+			float * w = m_velocity[2].data() ;
+			float * rhs = m_rhs.data() ;
+			const float halfCellSize = 0.5f*m_cellSize ;
+			// Divergence (zero gradient of the velocity on the boundary)
+			forEachSlab(nz, [=](int z)
+			{
+				const size_t zm = (z>0) ? sliceSize : 0, zp = (z<nz-1) ? sliceSize : 0 ;
+				for(int y=0 ; y<ny ; ++y)
+				{
+					const size_t ym = (y>0) ? nx : 0, yp = (y<ny-1) ? nx : 0 ;
+					size_t index = ((size_t)z*ny+y)*nx ;
+					for(int x=0 ; x<nx ; ++x, ++index)
+					{
+						const size_t xm = (x>0), xp = (x<nx-1) ;
+						rhs[index] = -halfCellSize*(u[index+xp]-u[index-xm]+v[index+yp]-v[index-ym]+w[index+zp]-w[index-zm]) ;
+					}
+				}
+			}) ;
+			// Preconditioned conjugate gradient
+			float * pressure = m_pressure.data() ;
+			float * residual = m_residual.data() ;
+			float * preconditioned = m_preconditioned.data() ;
+			float * direction = m_direction.data() ;
+			float * product = m_product.data() ;
+			const GridLevel & finest = m_levels[0] ;
+			laplacian(finest, pressure, residual, [=](size_t row, float * result)
+			{
+				for(int x=0 ; x<nx ; ++x) { result[x] = rhs[row+x]-result[x] ; }
+			}) ;
+			const double threshold = double(m_tolerance)*double(m_tolerance)*::std::max(dot(rhs, rhs), 1e-30) ;
+			m_lastIterations = 0 ;
+			if(dot(residual, residual)>threshold)
+			{
+				vCycle(0, preconditioned, residual) ;
+				::std::copy(preconditioned, preconditioned+size(), direction) ;
+				double rz = dot(residual, preconditioned) ;
+				for(int iteration=0 ; iteration<m_maxIterations ; ++iteration)
+				{
+					laplacian(finest, direction, product, [](size_t /*row*/, float * /*result*/) {}) ;
+					const float alpha = float(rz/dot(direction, product)) ;
+					forEachSlab(nz, [=](int z)
+					{
+						for(size_t cpt=z*sliceSize, end=cpt+sliceSize ; cpt<end ; ++cpt)
+						{
+							pressure[cpt] += alpha*direction[cpt] ;
+							residual[cpt] -= alpha*product[cpt] ;
+						}
+					}) ;
+					m_lastIterations = iteration+1 ;
+					if(dot(residual, residual)<=threshold) { break ; }
+					vCycle(0, preconditioned, residual) ;
+					double newRz = dot(residual, preconditioned) ;
+					const float beta = float(newRz/rz) ;
+					rz = newRz ;
+					forEachSlab(nz, [=](int z)
+					{
+						for(size_t cpt=z*sliceSize, end=cpt+sliceSize ; cpt<end ; ++cpt)
+						{
+							direction[cpt] = preconditioned[cpt]+beta*direction[cpt] ;
+						}
+					}) ;
+				}
+			}
+			// Gradient subtraction (zero pressure outside of the grid)
+			const float inverse2h = 0.5f/m_cellSize ;
+			const float * zero = m_zeroRow.data() ;
+			forEachSlab(nz, [=](int z)
+			{
+				for(int y=0 ; y<ny ; ++y)
+				{
+					const size_t row = ((size_t)z*ny+y)*nx ;
+					const float * center = pressure+row ;
+					const float * ym = (y>0) ? center-nx : zero ;
+					const float * yp = (y<ny-1) ? center+nx : zero ;
+					const float * zm = (z>0) ? center-sliceSize : zero ;
+					const float * zp = (z<nz-1) ? center+sliceSize : zero ;
+					for(int x=0 ; x<nx ; ++x)
+					{
+						float left = (x>0) ? center[x-1] : 0.0f ;
+						float right = (x<nx-1) ? center[x+1] : 0.0f ;
+						u[row+x] -= (right-left)*inverse2h ;
+						v[row+x] -= (yp[x]-ym[x])*inverse2h ;
+						w[row+x] -= (zp[x]-zm[x])*inverse2h ;
+					}
+				}
+			}) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	SmokeSolver::SmokeSolver(const Math::Vector3f & min, float cellSize, int resolutionX, int resolutionY, int resolutionZ)
+		///
+		/// \brief	Constructor. All the memory is allocated here.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	min		   	The lower corner of the domain.
+		/// \param	cellSize   	The size of the cells.
+		/// \param	resolutionX	The number of cells along x (at least 2).
+		/// \param	resolutionY	The number of cells along y (at least 2).
+		/// \param	resolutionZ	The number of cells along z (at least 2).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		SmokeSolver(const Math::Vector3f & min, float cellSize, int resolutionX, int resolutionY, int resolutionZ)
+			: m_min(min), m_cellSize(cellSize), m_up(Math::makeVector(0.0f, 0.0f, 1.0f)), m_densityBuoyancy(0.1f),
+			  m_temperatureBuoyancy(1.0f), m_vorticityConfinement(0.3f), m_densityDissipation(0.0f), m_temperatureDissipation(0.5f),
+			  m_tolerance(1e-3f), m_maxIterations(50), m_lastIterations(0), m_drag(1.0f)
+		{
+			assert(resolutionX>=2 && resolutionY>=2 && resolutionZ>=2 && "SmokeSolver: the resolution must be at least 2 on each axis") ;
+			m_resolution[0] = resolutionX ; m_resolution[1] = resolutionY ; m_resolution[2] = resolutionZ ;
+			const size_t cells = size() ;
+			for(int axis=0 ; axis<3 ; ++axis) { m_velocity[axis].assign(cells, 0.0f) ; }
+			m_density.assign(cells, 0.0f) ;
+			m_temperature.assign(cells, 0.0f) ;
+			for(int cpt=0 ; cpt<5 ; ++cpt) { m_buffers[cpt].assign(cells, 0.0f) ; }
+			m_pressure.assign(cells, 0.0f) ;
+			m_rhs.assign(cells, 0.0f) ;
+			m_residual.assign(cells, 0.0f) ;
+			m_preconditioned.assign(cells, 0.0f) ;
+			m_direction.assign(cells, 0.0f) ;
+			m_product.assign(cells, 0.0f) ;
+			m_zeroRow.assign(resolutionX, 0.0f) ;
+			// Multigrid hierarchy, the cell size is doubled while each axis has at least 8 cells
+			m_levels.push_back(GridLevel(resolutionX, resolutionY, resolutionZ)) ;
+			m_levels.back().m_residual.assign(cells, 0.0f) ;
+			while(::std::min(::std::min(m_levels.back().m_resolution[0], m_levels.back().m_resolution[1]), m_levels.back().m_resolution[2])>=8)
+			{
+				const GridLevel & fine = m_levels.back() ;
+				GridLevel coarse((fine.m_resolution[0]+1)/2, (fine.m_resolution[1]+1)/2, (fine.m_resolution[2]+1)/2) ;
+				coarse.m_solution.assign(coarse.size(), 0.0f) ;
+				coarse.m_rhs.assign(coarse.size(), 0.0f) ;
+				coarse.m_residual.assign(coarse.size(), 0.0f) ;
+				m_levels.push_back(coarse) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3f SmokeSolver::cellCenter(int x, int y, int z) const
+		///
+		/// \brief	Gets the center of a cell.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3f cellCenter(int x, int y, int z) const
+		{
+			return m_min+Math::makeVector(float(x)+0.5f, float(y)+0.5f, float(z)+0.5f)*m_cellSize ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::addSource(const Math::Vector3f & center, float radius, float density, float temperature, const Math::Vector3f & velocity = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Adds a spherical source of smoke.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	center	   	The center of the source.
+		/// \param	radius	   	The radius of the source.
+		/// \param	density	   	The density added per second.
+		/// \param	temperature	The temperature added per second.
+		/// \param	velocity   	(optional) the inflow velocity (ignored if null).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void addSource(const Math::Vector3f & center, float radius, float density, float temperature, const Math::Vector3f & velocity = Math::makeVector(0.0f, 0.0f, 0.0f))
+		{
+			Source source ;
+			source.m_center = center ;
+			source.m_radius = radius ;
+			source.m_density = density ;
+			source.m_temperature = temperature ;
+			source.m_velocity = velocity ;
+			m_sources.push_back(source) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::setBuoyancy(const Math::Vector3f & up, float densityWeight, float temperatureWeight)
+		///
+		/// \brief	Sets the buoyancy: the force (temperatureWeight * temperature - densityWeight * density) * up
+		/// 		is applied to each cell.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setBuoyancy(const Math::Vector3f & up, float densityWeight, float temperatureWeight)
+		{
+			m_up = up/up.norm() ;
+			m_densityBuoyancy = densityWeight ;
+			m_temperatureBuoyancy = temperatureWeight ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::setVorticityConfinement(float confinement)
+		///
+		/// \brief	Sets the strength of the vorticity confinement (0 disables it).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setVorticityConfinement(float confinement)
+		{
+			m_vorticityConfinement = confinement ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::setDissipation(float density, float temperature)
+		///
+		/// \brief	Sets the dissipation rates (per second) of the density and the temperature.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setDissipation(float density, float temperature)
+		{
+			m_densityDissipation = density ;
+			m_temperatureDissipation = temperature ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::setSolverParameters(float tolerance, int maxIterations)
+		///
+		/// \brief	Sets the relative tolerance and the maximum number of iterations of the pressure solve.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setSolverParameters(float tolerance, int maxIterations)
+		{
+			m_tolerance = tolerance ;
+			m_maxIterations = maxIterations ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int SmokeSolver::lastIterations() const
+		///
+		/// \brief	Gets the number of conjugate gradient iterations of the last pressure solve.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int lastIterations() const
+		{
+			return m_lastIterations ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::setDrag(float drag)
+		///
+		/// \brief	Sets the drag coefficient of the particles advected by the smoke (see operator()).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setDrag(float drag)
+		{
+			m_drag = drag ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::update(float dt)
+		///
+		/// \brief	Updates the smoke.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	dt	The time step.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update(float dt)
+		{
+			applySources(dt) ;
+			advect(dt) ;
+			applyForces(dt) ;
+			project() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3f SmokeSolver::velocity(const Math::Vector3f & position) const
+		///
+		/// \brief	Samples the velocity (trilinear interpolation, positions outside of the domain are clamped).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3f velocity(const Math::Vector3f & position) const
+		{
+			Stencil weights = stencil(position) ;
+			return Math::makeVector(weights(m_velocity[0].data()), weights(m_velocity[1].data()), weights(m_velocity[2].data())) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float SmokeSolver::density(const Math::Vector3f & position) const
+		///
+		/// \brief	Samples the density of the smoke.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float density(const Math::Vector3f & position) const
+		{
+			return stencil(position)(m_density.data()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float SmokeSolver::temperature(const Math::Vector3f & position) const
+		///
+		/// \brief	Samples the temperature of the smoke.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float temperature(const Math::Vector3f & position) const
+		{
+			return stencil(position)(m_temperature.data()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::vector<float> & SmokeSolver::densities() const
+		///
+		/// \brief	Gets the density of each cell (x varies first, then y, then z).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::vector<float> & densities() const
+		{
+			return m_density ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3f SmokeSolver::operator() (const PonctualMass & mass) const
+		///
+		/// \brief	Force functor interface: drag force drag * mass * (smoke velocity - mass speed).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3f operator() (const PonctualMass & mass) const
+		{
+			return (velocity(mass.m_position)-mass.m_speed)*(m_drag*mass.m_mass) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SmokeSolver::attach(ParticleSystem & system, bool updateSmoke = true)
+		///
+		/// \brief	Attaches the smoke to a particle system: a parallel modifier adds the drag force of the
+		/// 		smoke to the forces of each particle. If updateSmoke is true, a system modifier updates
+		/// 		the smoke first with the time step of the particle system. The forces must have been
+		/// 		reset by a previous modifier and the integration must be done by a following modifier.
+		/// 		This object must outlive the particle system.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	system	The particle system.
+		/// \param	updateSmoke   	(optional) true to update the smoke with the particle system.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void attach(ParticleSystem & system, bool updateSmoke = true)
+		{
+			SmokeSolver * self = this ;
+			if(updateSmoke)
+			{
+				system.addSystemModifier([self](const ParticleSystem::ConstParticleRange & /*particles*/, float dt) { self->update(dt) ; }) ;
+			}
+			system.addModifier([self](Particle & particle, float /*dt*/) { particle.m_forces += (*self)(particle) ; }, true) ;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,488 @@
+#ifndef _Animation_SphFluid_H
+#define _Animation_SphFluid_H
+
+#include <Animation/ParticleSystem.h>
+#include <Utils/RadixSort.h>
+#include <Math/Constant.h>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	SphFluid
+	///
+	/// \brief	A fluid simulated with Smoothed Particle Hydrodynamics (Mller et al. 2003: poly6 kernel
+	/// 		for the density, spiky kernel for the pressure, viscosity kernel for the viscosity).
+	/// 		The fluid is a particle system: particles are emitted, modified, killed and displayed
+	/// 		as the particles of a ParticleSystem. The fluid is confined in an axis aligned box
+	/// 		which is divided in cells of size the smoothing radius. At each update, the particles
+	/// 		are sorted by cell (parallel radix sort) and their positions / speeds are copied in
+	/// 		contiguous arrays: the neighbors of a particle are stored in 9 contiguous ranges
+	/// 		(the three cells along x of a line are consecutive). Density, pressure and force
+	/// 		passes run in parallel. The particles are then integrated (semi-implicit Euler) and
+	/// 		the modifiers, death functions and emitters of the particle system are applied. The
+	/// 		force computed by the SPH step is stored in Particle::m_forces, modifiers must not
+	/// 		integrate the particles. As the sort moves all the particles, the index of a particle
+	/// 		changes at each update: the identifiers (see ParticleSystem::identifiers) follow the
+	/// 		particles and must be used to follow them between updates.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class SphFluid : public ParticleSystem
+	{
+	protected:
+		/// \brief	The lower corner of the simulation domain.
+		Math::Vector3f m_domainMin ;
+		/// \brief	The upper corner of the simulation domain.
+		Math::Vector3f m_domainMax ;
+		/// \brief	The smoothing radius (size of the cells).
+		float m_smoothingRadius ;
+		/// \brief	The grid resolution.
+		int m_gridSize[3] ;
+		/// \brief	The rest density of the fluid.
+		float m_restDensity ;
+		/// \brief	The stiffness of the fluid (pressure = stiffness * max(density - restDensity, 0)).
+		float m_stiffness ;
+		/// \brief	The viscosity of the fluid.
+		float m_viscosity ;
+		/// \brief	The gravity.
+		Math::Vector3f m_gravity ;
+		/// \brief	Fraction of the normal speed kept after a collision with the domain boundary.
+		float m_restitution ;
+
+		/// \brief	The cell key of each particle.
+		::std::vector<::std::uint32_t> m_cellKeys ;
+		/// \brief	The sorter used to sort the particles by cell.
+		Utils::RadixSort m_sorter ;
+		/// \brief	Index of the first (sorted) particle of each cell, m_cellStart[cell+1] is the end of the cell.
+		::std::vector<::std::uint32_t> m_cellStart ;
+		/// \brief	Particle pool used to reorder the particles.
+		::std::vector<Particle> m_sortedParticles ;
+		/// \brief	The identifiers of the particles in the cell order (buffer of the sort).
+		::std::vector<::std::uint32_t> m_sortedIdentifiers ;
+		/// \brief	The positions of the sorted particles.
+		::std::vector<Math::Vector3f> m_positions ;
+		/// \brief	The speeds of the sorted particles.
+		::std::vector<Math::Vector3f> m_speeds ;
+		/// \brief	The masses of the sorted particles.
+		::std::vector<float> m_masses ;
+		/// \brief	The densities of the sorted particles.
+		::std::vector<float> m_densities ;
+		/// \brief	The pressures of the sorted particles.
+		::std::vector<float> m_pressures ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int SphFluid::cellCoordinate(float value, int axis) const
+		///
+		/// \brief	Computes the cell coordinate of a value on a given axis (clamped in the grid).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	value	The value.
+		/// \param	axis 	The axis.
+		///
+		/// \return	The cell coordinate.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int cellCoordinate(float value, int axis) const
+		{
+			int result = (int)((value-m_domainMin[axis])/m_smoothingRadius) ;
+			return ::std::min(::std::max(result, 0), m_gridSize[axis]-1) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	::std::uint32_t SphFluid::cellKey(int x, int y, int z) const
+		///
+		/// \brief	Computes the key of a cell, cells of a same line along x have consecutive keys.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		::std::uint32_t cellKey(int x, int y, int z) const
+		{
+			return (::std::uint32_t)((z*m_gridSize[1]+y)*m_gridSize[0]+x) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Function> void SphFluid::forEachNeighborRange(const Math::Vector3f & position, Function function) const
+		///
+		/// \brief	Calls function(begin, end) for the 9 ranges of sorted particles stored in the 27
+		/// 		cells surrounding position.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Function>
+		void forEachNeighborRange(const Math::Vector3f & position, Function function) const
+		{
+			int x = cellCoordinate(position[0], 0) ;
+			int y = cellCoordinate(position[1], 1) ;
+			int z = cellCoordinate(position[2], 2) ;
+			int xMin = ::std::max(x-1, 0), xMax = ::std::min(x+1, m_gridSize[0]-1) ;
+			int yMin = ::std::max(y-1, 0), yMax = ::std::min(y+1, m_gridSize[1]-1) ;
+			int zMin = ::std::max(z-1, 0), zMax = ::std::min(z+1, m_gridSize[2]-1) ;
+			const ::std::uint32_t * cellStart = m_cellStart.data() ;
+			for(int cz=zMin ; cz<=zMax ; ++cz)
+			{
+				for(int cy=yMin ; cy<=yMax ; ++cy)
+				{
+					function(cellStart[cellKey(xMin, cy, cz)], cellStart[cellKey(xMax, cy, cz)+1]) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::sortParticles()
+		///
+		/// \brief	Sorts the particles by cell, copies the positions, speeds and masses in the contiguous
+		/// 		arrays and computes the start of each cell. The identifiers follow the particles.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void sortParticles()
+		{
+			const size_t size = m_size ;
+			const size_t cells = m_cellStart.size()-1 ;
+			const size_t grainSize = m_grainSize ;
+			m_cellKeys.resize(size) ;
+			::std::uint32_t * keys = m_cellKeys.data() ;
+			Particle * particles = m_particles.data() ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, grainSize), [this, keys, particles](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Math::Vector3f & position = particles[cpt].m_position ;
+					keys[cpt] = cellKey(cellCoordinate(position[0], 0), cellCoordinate(position[1], 1), cellCoordinate(position[2], 2)) ;
+				}
+			}) ;
+			m_sorter.sort(keys, size, (::std::uint32_t)(cells-1)) ;
+			const ::std::uint32_t * permutation = m_sorter.permutation() ;
+			const ::std::uint32_t * sortedKeys = m_sorter.keys() ;
+			Particle * sorted = m_sortedParticles.data() ;
+			const ::std::uint32_t * identifiers = m_identifiers.data() ;
+			::std::uint32_t * sortedIdentifiers = m_sortedIdentifiers.data() ;
+			Math::Vector3f * positions = m_positions.data() ;
+			Math::Vector3f * speeds = m_speeds.data() ;
+			float * masses = m_masses.data() ;
+			::std::uint32_t * cellStart = m_cellStart.data() ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, grainSize),
+				[particles, sorted, identifiers, sortedIdentifiers, positions, speeds, masses, permutation, sortedKeys, cellStart, size, cells](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Particle & particle = particles[permutation[cpt]] ;
+					sorted[cpt] = particle ;
+					sortedIdentifiers[cpt] = identifiers[permutation[cpt]] ;
+					positions[cpt] = particle.m_position ;
+					speeds[cpt] = particle.m_speed ;
+					masses[cpt] = particle.m_mass ;
+					// Cells in (previous key ; key] start at cpt
+					size_t first = (cpt==0) ? 0 : sortedKeys[cpt-1]+1 ;
+					for(size_t cell=first ; cell<=sortedKeys[cpt] ; ++cell) { cellStart[cell] = (::std::uint32_t)cpt ; }
+					if(cpt==size-1)
+					{
+						for(size_t cell=sortedKeys[cpt]+1 ; cell<=cells ; ++cell) { cellStart[cell] = (::std::uint32_t)size ; }
+					}
+				}
+			}) ;
+			m_particles.swap(m_sortedParticles) ;
+			// The identifiers of the free particles (after size) are kept in place
+			::std::copy(sortedIdentifiers, sortedIdentifiers+size, m_identifiers.begin()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::computeDensities()
+		///
+		/// \brief	Computes the density (poly6 kernel) and the pressure of each particle.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeDensities()
+		{
+			const float h2 = m_smoothingRadius*m_smoothingRadius ;
+			const float poly6 = 315.0f/(64.0f*(float)Math::pi*::std::pow(m_smoothingRadius, 9.0f)) ;
+			const float restDensity = m_restDensity ;
+			const float stiffness = m_stiffness ;
+			const Math::Vector3f * positions = m_positions.data() ;
+			const float * masses = m_masses.data() ;
+			float * densities = m_densities.data() ;
+			float * pressures = m_pressures.data() ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_size, m_grainSize),
+				[this, h2, poly6, restDensity, stiffness, positions, masses, densities, pressures](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Math::Vector3f position = positions[cpt] ;
+					float density = 0.0f ;
+					forEachNeighborRange(position, [&](::std::uint32_t begin, ::std::uint32_t end)
+					{
+						float sum = 0.0f ; // Local accumulation (no dependency through memory)
+						for(::std::uint32_t neighbor=begin ; neighbor<end ; ++neighbor)
+						{
+							float dx = positions[neighbor][0]-position[0] ;
+							float dy = positions[neighbor][1]-position[1] ;
+							float dz = positions[neighbor][2]-position[2] ;
+							float delta = ::std::max(h2-(dx*dx+dy*dy+dz*dz), 0.0f) ;
+							sum += masses[neighbor]*delta*delta*delta ;
+						}
+						density += sum ;
+					}) ;
+					densities[cpt] = density*poly6 ;
+					// Negative pressures are clamped (no tensile instability at the free surface)
+					pressures[cpt] = stiffness*::std::max(densities[cpt]-restDensity, 0.0f) ;
+				}
+			}) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::computeForcesAndIntegrate(float dt)
+		///
+		/// \brief	Computes the pressure and viscosity forces (spiky and viscosity kernels), adds the
+		/// 		gravity and integrates the particles (semi-implicit Euler). Particles leaving the
+		/// 		domain are projected on its boundary.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	dt	The time step.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeForcesAndIntegrate(float dt)
+		{
+			const float h = m_smoothingRadius ;
+			const float h2 = h*h ;
+			const float spiky = -45.0f/((float)Math::pi*::std::pow(h, 6.0f)) ;
+			const float viscosityLaplacian = 45.0f/((float)Math::pi*::std::pow(h, 6.0f)) ;
+			const float viscosity = m_viscosity ;
+			const float restitution = m_restitution ;
+			const Math::Vector3f gravity = m_gravity ;
+			const Math::Vector3f domainMin = m_domainMin ;
+			const Math::Vector3f domainMax = m_domainMax ;
+			const Math::Vector3f * positions = m_positions.data() ;
+			const Math::Vector3f * speeds = m_speeds.data() ;
+			const float * masses = m_masses.data() ;
+			const float * densities = m_densities.data() ;
+			const float * pressures = m_pressures.data() ;
+			Particle * particles = m_particles.data() ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_size, m_grainSize),
+				[&, positions, speeds, masses, densities, pressures, particles](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Math::Vector3f position = positions[cpt] ;
+					const Math::Vector3f speed = speeds[cpt] ;
+					const float pressure = pressures[cpt] ;
+					Math::Vector3f pressureForce = Math::makeVector(0.0f, 0.0f, 0.0f) ;
+					Math::Vector3f viscosityForce = Math::makeVector(0.0f, 0.0f, 0.0f) ;
+					forEachNeighborRange(position, [&](::std::uint32_t begin, ::std::uint32_t end)
+					{
+						for(::std::uint32_t neighbor=begin ; neighbor<end ; ++neighbor)
+						{
+							Math::Vector3f delta = position-positions[neighbor] ;
+							float r2 = delta.norm2() ;
+							if(r2>=h2 || neighbor==cpt) { continue ; }
+							float r = ::std::sqrt(r2) ;
+							float weight = masses[neighbor]/densities[neighbor] ;
+							if(r>1e-6f)
+							{
+								// -grad(W_spiky)*(pi+pj)/2, delta points from the neighbor to the particle
+								pressureForce += delta*(-weight*(pressure+pressures[neighbor])*0.5f*spiky*(h-r)*(h-r)/r) ;
+							}
+							viscosityForce += (speeds[neighbor]-speed)*(weight*viscosityLaplacian*(h-r)) ;
+						}
+					}) ;
+					Particle & particle = particles[cpt] ;
+					// Force density divided by the density gives the acceleration
+					Math::Vector3f acceleration = (pressureForce+viscosityForce*viscosity)/densities[cpt]+gravity ;
+					particle.m_forces = acceleration*particle.m_mass ;
+					particle.m_speed = speed+acceleration*dt ;
+					particle.m_position = position+particle.m_speed*dt ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						if(particle.m_position[axis]<domainMin[axis])
+						{
+							particle.m_position[axis] = domainMin[axis] ;
+							if(particle.m_speed[axis]<0.0f) { particle.m_speed[axis] *= -restitution ; }
+						}
+						else if(particle.m_position[axis]>domainMax[axis])
+						{
+							particle.m_position[axis] = domainMax[axis] ;
+							if(particle.m_speed[axis]>0.0f) { particle.m_speed[axis] *= -restitution ; }
+						}
+					}
+				}
+			}) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	SphFluid::SphFluid(unsigned int budget, const Math::Vector3f & domainMin,
+		/// 	const Math::Vector3f & domainMax, float smoothingRadius, size_t grainSize = 2000)
+		///
+		/// \brief	Constructor. Default parameters correspond to water (rest density 1000, stiffness 3,
+		/// 		viscosity 3.5, earth gravity along -z).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	budget		   	The particle budget.
+		/// \param	domainMin	   	The lower corner of the simulation domain.
+		/// \param	domainMax	   	The upper corner of the simulation domain.
+		/// \param	smoothingRadius	The smoothing radius of the kernels.
+		/// \param	grainSize	   	(optional) the grain size used for parallel updates.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		SphFluid(unsigned int budget, const Math::Vector3f & domainMin, const Math::Vector3f & domainMax, float smoothingRadius, size_t grainSize = 2000)
+			: ParticleSystem(budget, grainSize), m_domainMin(domainMin), m_domainMax(domainMax), m_smoothingRadius(smoothingRadius),
+			  m_restDensity(1000.0f), m_stiffness(3.0f), m_viscosity(3.5f), m_gravity(Math::makeVector(0.0f, 0.0f, -9.807f)), m_restitution(0.3f),
+			  m_cellKeys(budget), m_sortedParticles(budget), m_sortedIdentifiers(budget), m_positions(budget), m_speeds(budget), m_masses(budget),
+			  m_densities(budget), m_pressures(budget)
+		{
+			assert(smoothingRadius>0.0f) ;
+			size_t cells = 1 ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_gridSize[axis] = ::std::max(1, (int)::std::ceil((domainMax[axis]-domainMin[axis])/smoothingRadius)) ;
+				cells *= m_gridSize[axis] ;
+			}
+			m_cellStart.resize(cells+1) ;
+			m_sorter.reserve(budget) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::setRestDensity(float density)
+		///
+		/// \brief	Sets the rest density of the fluid.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setRestDensity(float density) { m_restDensity = density ; }
+
+		float restDensity() const { return m_restDensity ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::setStiffness(float stiffness)
+		///
+		/// \brief	Sets the stiffness (gas constant) of the fluid.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setStiffness(float stiffness) { m_stiffness = stiffness ; }
+
+		float stiffness() const { return m_stiffness ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::setViscosity(float viscosity)
+		///
+		/// \brief	Sets the viscosity of the fluid.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setViscosity(float viscosity) { m_viscosity = viscosity ; }
+
+		float viscosity() const { return m_viscosity ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::setGravity(const Math::Vector3f & gravity)
+		///
+		/// \brief	Sets the gravity (an acceleration).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setGravity(const Math::Vector3f & gravity) { m_gravity = gravity ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SphFluid::setRestitution(float restitution)
+		///
+		/// \brief	Sets the fraction of the normal speed kept after a collision with the domain boundary.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setRestitution(float restitution) { m_restitution = restitution ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const float * SphFluid::densities() const
+		///
+		/// \brief	Gets the densities computed during the last update. densities()[i] is the density
+		/// 		of the i-th particle before death and emission of the last update.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const float * densities() const { return m_densities.data() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t SphFluid::addBlock(const Math::Vector3f & blockMin, const Math::Vector3f & blockMax,
+		/// 	float spacing, const HelperGl::Color & color = HelperGl::Color(0.2f, 0.4f, 1.0f))
+		///
+		/// \brief	Fills a box with fluid particles placed on a regular grid. The mass of the particles
+		/// 		is restDensity*spacing^3. A spacing close to half the smoothing radius gives a
+		/// 		fluid near its rest density.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	blockMin	The lower corner of the box.
+		/// \param	blockMax	The upper corner of the box.
+		/// \param	spacing 	The spacing between particles.
+		/// \param	color   	(optional) the color of the particles.
+		///
+		/// \return	The number of created particles (clamped by the budget).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t addBlock(const Math::Vector3f & blockMin, const Math::Vector3f & blockMax, float spacing, const HelperGl::Color & color = HelperGl::Color(0.2f, 0.4f, 1.0f))
+		{
+			int counts[3] ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				counts[axis] = ::std::max(1, (int)((blockMax[axis]-blockMin[axis])/spacing)+1) ;
+			}
+			ParticleAllocator allocator(m_particles.data(), m_size, m_effectiveBudget) ;
+			ParticleRange range = allocator.allocate((size_t)counts[0]*counts[1]*counts[2]) ;
+			const float mass = m_restDensity*spacing*spacing*spacing ;
+			for(size_t cpt=0 ; cpt<range.size() ; ++cpt)
+			{
+				int x = (int)(cpt%counts[0]) ;
+				int y = (int)((cpt/counts[0])%counts[1]) ;
+				int z = (int)(cpt/((size_t)counts[0]*counts[1])) ;
+				range[cpt] = Particle(blockMin+Math::makeVector(x*spacing, y*spacing, z*spacing), mass, color) ;
+			}
+			return range.size() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void SphFluid::update(float dt)
+		///
+		/// \brief	Updates the fluid: SPH step (sort, densities, forces and integration) then modifiers,
+		/// 		death functions and emitters of the particle system. The SPH scheme is explicit, dt
+		/// 		must be small (typically lower than 0.4*smoothingRadius/maximum speed).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	dt	The time step.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual void update(float dt)
+		{
+			if(m_size>0)
+			{
+				sortParticles() ;
+				computeDensities() ;
+				computeForcesAndIntegrate(dt) ;
+			}
+			ParticleSystem::update(dt) ;
+		}
+	};
+}
+
+#endif
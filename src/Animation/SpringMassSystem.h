@@ -12,6 +12,7 @@
 #include <tbb/combinable.h>
 #include <Utils/History.h>
 #include <Animation/PonctualMass.h>
+#include <Animation/Physics.h>
 
 namespace Animation
 {
@@ -402,11 +403,29 @@ namespace Animation
 		/// \date	17/02/2016
 		///
 		/// \tparam	MassForceFunction	Type of the mass force function.
-		/// \param	function	The function. Signature : Math::Vector3f (const Mass &amp; mass)
+		/// \param	function	The function. Signature : Math::Vector3f (const Mass &amp; mass). If the
+		/// 					function also provides the batch evaluation (see Physics::HasMassBatch), the
+		/// 					masses are processed by batches.
 		/// \param	parallel	(optional) True is update must run in parallel, false otherwise.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		template <class MassForceFunction> 
 		void addForceFunction(const MassForceFunction & function, bool parallel = false)
+		{
+			addForceFunction(function, parallel, typename Physics::HasMassBatch<MassForceFunction>::type()) ;
+		}
+
+	protected:
+		/// \brief	Size of the batches used by the batch evaluation of forces.
+		typedef Physics::MassBatchBuffer<256> BatchBuffer ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \brief	Adds a force function evaluated mass per mass.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	17/02/2016
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class MassForceFunction> 
+		void addForceFunction(const MassForceFunction & function, bool parallel, ::std::false_type)
 		{
 			// If a compile error occurs here, your provided function does not have the required signature
 			::std::function<Math::Vector3f (const Mass & mass)> verification = function ;
@@ -445,6 +464,63 @@ namespace Animation
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class MassForceFunction> static void SpringMassSystem::applyForceBatch(const MassForceFunction & function, ::std::vector<Mass> & masses, size_t begin, size_t end)
+		///
+		/// \brief	Gathers the masses [begin;end) by batches, evaluates the batch force function and adds
+		/// 		the result to the forces of the masses.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class MassForceFunction>
+		static void applyForceBatch(const MassForceFunction & function, ::std::vector<Mass> & masses, size_t begin, size_t end)
+		{
+			BatchBuffer buffer ;
+			for(size_t first=begin ; first<end ; first+=BatchBuffer::maxSize)
+			{
+				Mass * batch = &masses[first] ;
+				buffer.load(end-first, [batch](size_t index) -> const Mass & { return batch[index] ; }) ;
+				function(buffer.masses(), buffer.forces()) ;
+				for(size_t cpt=0 ; cpt<buffer.size() ; ++cpt) { batch[cpt].m_forces += buffer.force(cpt) ; }
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \brief	Adds a force function providing the batch evaluation.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class MassForceFunction> 
+		void addForceFunction(const MassForceFunction & function, bool parallel, ::std::true_type)
+		{
+			if(!parallel)
+			{
+				auto modifier = [this, function]()
+				{
+					applyForceBatch(function, m_masses.current(), 0, m_masses.current().size()) ;
+				} ;
+				m_modifiers.push_back(modifier) ;
+			}
+			else
+			{
+				auto modifier = [this, function]()
+				{
+					auto & refFunction = function ;
+					::std::vector<Mass> & masses = m_masses.current() ;
+					auto subFunction = [&refFunction, &masses](::tbb::blocked_range<size_t> const & range)
+					{
+						applyForceBatch(refFunction, masses, range.begin(), range.end()) ;
+					} ;
+					::tbb::parallel_for(::tbb::blocked_range<size_t>(0, masses.size(), 8*BatchBuffer::maxSize), subFunction) ;
+				} ;
+				m_modifiers.push_back(modifier) ;
+			}
+		}
+
+	public:
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \brief	Adds a link force function.
 		///
@@ -455,10 +531,26 @@ namespace Animation
 		/// \param	function	The function. Signature : Math::Vector3f (const Mass &amp; mass1, const
 		/// 					Mass &amp; mass2, const Link &amp; link). This function must return the force
 		/// 					applied on mass1, the reciprocal force will be automatically applied on mass2.
+		/// 					A function providing the batch evaluation of links (see Physics::HasLinkBatch,
+		/// 					for instance Physics::SpringForce) is used directly, the rest length of the
+		/// 					links being their initial length.
 		/// \param	parallel	(optional) True if update must be done in parallel, false otherwise.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		template <class LinkForceFunction> 
 		void addLinkForceFunction(const LinkForceFunction & function, bool parallel=false)
+		{
+			addLinkForceFunction(function, parallel, typename Physics::HasLinkBatch<LinkForceFunction>::type()) ;
+		}
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \brief	Adds a link force function evaluated link per link.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	17/02/2016
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LinkForceFunction> 
+		void addLinkForceFunction(const LinkForceFunction & function, bool parallel, ::std::false_type)
 		{
 			// If a compile error occurs here, your provided function does not have the required signature
 			::std::function<Math::Vector3f (const Mass & mass1, const Mass & mass2, const Link & link)> verification = function ; 
@@ -527,6 +619,90 @@ namespace Animation
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LinkForceFunction, class Accumulate> static void SpringMassSystem::applyLinkForceBatch(const LinkForceFunction & function, const ::std::vector<Mass> & masses, const ::std::vector<Link> & links, size_t begin, size_t end, Accumulate & accumulate)
+		///
+		/// \brief	Evaluates the batch link force function on the links [begin;end). accumulate(link,
+		/// 		force) receives the force applied on the first mass of each link.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LinkForceFunction, class Accumulate>
+		static void applyLinkForceBatch(const LinkForceFunction & function, const ::std::vector<Mass> & masses, const ::std::vector<Link> & links, size_t begin, size_t end, Accumulate & accumulate)
+		{
+			BatchBuffer buffer1 ;
+			BatchBuffer buffer2 ;
+			float lengths[BatchBuffer::maxSize] ;
+			for(size_t first=begin ; first<end ; first+=BatchBuffer::maxSize)
+			{
+				const Link * batch = &links[first] ;
+				buffer1.load(end-first, [batch, &masses](size_t index) -> const Mass & { return masses[batch[index].m_firstMass] ; }) ;
+				buffer2.load(end-first, [batch, &masses](size_t index) -> const Mass & { return masses[batch[index].m_secondMass] ; }) ;
+				for(size_t cpt=0 ; cpt<buffer1.size() ; ++cpt) { lengths[cpt] = batch[cpt].m_initialLength ; }
+				function(buffer1.masses(), buffer2.masses(), static_cast<const float*>(lengths), buffer1.forces()) ;
+				for(size_t cpt=0 ; cpt<buffer1.size() ; ++cpt) { accumulate(batch[cpt], buffer1.force(cpt)) ; }
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \brief	Adds a link force function providing the batch evaluation.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LinkForceFunction> 
+		void addLinkForceFunction(const LinkForceFunction & function, bool parallel, ::std::true_type)
+		{
+			if(!parallel)
+			{
+				auto modifier = [this, function]()
+				{
+					::std::vector<Mass> & currentMasses = m_masses.current() ;
+					auto accumulate = [&currentMasses](const Link & link, const Math::Vector3f & force)
+					{
+						currentMasses[link.m_firstMass].m_forces += force ;
+						currentMasses[link.m_secondMass].m_forces -= force ;
+					} ;
+					applyLinkForceBatch(function, currentMasses, m_links, 0, m_links.size(), accumulate) ;
+				} ;
+				m_modifiers.push_back(modifier) ;
+			}
+			else
+			{
+				auto modifier = [this, function]()
+				{
+					auto & refFunction = function ;
+					const ::std::vector<Link> & links = m_links ;
+					::std::vector<Mass> & currentMasses = m_masses.current() ;
+					// Thread local storage used to cache and sum computed forces while avoiding read / write conflicts
+					::tbb::combinable<::std::vector<Math::Vector3f> > computedForces([&currentMasses]() { return ::std::vector<Math::Vector3f>(currentMasses.size(), Math::makeVector(0.0f,0.0f,0.0f)) ; }) ;
+					auto subFunction = [&refFunction, &links, &currentMasses, &computedForces](::tbb::blocked_range<size_t> const & range)
+					{
+						::std::vector<Math::Vector3f> & localForces = computedForces.local() ;
+						auto accumulate = [&localForces](const Link & link, const Math::Vector3f & force)
+						{
+							localForces[link.m_firstMass] += force ;
+							localForces[link.m_secondMass] -= force ;
+						} ;
+						applyLinkForceBatch(refFunction, currentMasses, links, range.begin(), range.end(), accumulate) ;
+					} ;
+					::tbb::parallel_for(::tbb::blocked_range<size_t>(0, links.size(), 8*BatchBuffer::maxSize), subFunction) ;
+					computedForces.combine_each([&currentMasses](const ::std::vector<Math::Vector3f> & v)
+					{
+						auto updateForce = [&currentMasses, &v](::tbb::blocked_range<size_t> const & range)
+						{
+							for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt) { currentMasses[cpt].m_forces += v[cpt] ; }
+						} ;
+						::tbb::parallel_for(::tbb::blocked_range<size_t>(0, v.size(), 2000), updateForce) ;
+					}) ;
+				} ;
+				m_modifiers.push_back(modifier) ;
+			}
+		}
+
+	public:
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \brief	Adds a position constraint.
 		///
@@ -0,0 +1,252 @@
+#ifndef _Animation_WarmStartIK_H
+#define _Animation_WarmStartIK_H
+
+#include <Animation/CompiledKinematicChain.h>
+#include <Animation/DampedLeastSquaresIK.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+namespace Animation
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	WarmStartIK
+	///
+	/// \brief	Temporal coherence layer for interactive inverse kinematics on a compiled chain (one
+	/// 		instance per chain / extremity). The last converged pose is kept with the target it
+	/// 		reaches and the velocity of the target. When a new target is given:
+	/// 		- if it moved less than the skip tolerance, the last converged pose is reused without
+	/// 		  solving;
+	/// 		- otherwise, the initial guess extrapolates the last two converged poses according to the
+	/// 		  displacement of the target relatively to its previous velocity. The extrapolated guess
+	/// 		  is only used if it is closer to the target than the last converged pose.
+	/// 		A solve which does not converge forgets the history: the next one starts from the pose
+	/// 		of the caller (the best pose found). Counters give the cost of the solves.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \tparam	Solver	The solver (DampedLeastSquaresIK or Fabrik), built from (chain, extremity, offset)
+	/// 				and providing Result solve(float * pose, const Math::Vector3f & target,
+	/// 				unsigned int maxIterations, float tolerance).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <class Solver = DampedLeastSquaresIK>
+	class WarmStartIK
+	{
+	public:
+		typedef DampedLeastSquaresIK::Result Result ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Statistics
+		///
+		/// \brief	Counters accumulated by the solves.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		class Statistics
+		{
+		public:
+			/// \brief	The number of calls to solve.
+			unsigned int m_solves ;
+			/// \brief	The number of calls for which the solver was not run.
+			unsigned int m_skipped ;
+			/// \brief	The number of calls which converged.
+			unsigned int m_converged ;
+			/// \brief	The total number of iterations of the solver.
+			unsigned int m_iterations ;
+			/// \brief	The total time spent in solve (seconds).
+			double m_seconds ;
+
+			Statistics()
+				: m_solves(0), m_skipped(0), m_converged(0), m_iterations(0), m_seconds(0.0)
+			{}
+
+			/// \brief	Gets the average number of iterations per call.
+			float averageIterations() const
+			{
+				return (m_solves==0) ? 0.0f : float(m_iterations)/float(m_solves) ;
+			}
+
+			/// \brief	Gets the average time per call, in microseconds.
+			double averageMicroseconds() const
+			{
+				return (m_solves==0) ? 0.0 : m_seconds*1e6/double(m_solves) ;
+			}
+		};
+
+	protected:
+		typedef ::std::chrono::steady_clock Clock ;
+
+		/// \brief	The compiled chain.
+		const CompiledKinematicChain * m_chain ;
+		/// \brief	The index of the extremity in the compiled chain.
+		int m_extremity ;
+		/// \brief	The offset from the extremity.
+		Math::Vector3f m_offset ;
+		/// \brief	The solver.
+		Solver m_solver ;
+		/// \brief	Forward kinematics used to evaluate the initial guesses.
+		CompiledKinematicChain::Workspace m_workspace ;
+		/// \brief	The last converged pose.
+		::std::vector<float> m_lastPose ;
+		/// \brief	The converged pose before the last one.
+		::std::vector<float> m_previousPose ;
+		/// \brief	The extrapolated pose.
+		::std::vector<float> m_guess ;
+		/// \brief	The target reached by the last converged pose.
+		Math::Vector3f m_lastTarget ;
+		/// \brief	The displacement of the target between the last two converged poses.
+		Math::Vector3f m_targetVelocity ;
+		/// \brief	The residual of the last converged pose.
+		float m_lastResidual ;
+		/// \brief	The number of valid converged poses (0, 1 or 2).
+		int m_history ;
+		/// \brief	The displacement of the target under which the solver is not run.
+		float m_skipTolerance ;
+		/// \brief	Is the initial guess extrapolated?
+		bool m_extrapolate ;
+		/// \brief	The counters.
+		Statistics m_statistics ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void WarmStartIK::initialGuess(float * pose, const Math::Vector3f & target)
+		///
+		/// \brief	Writes the initial guess for target in pose (requires a converged pose).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void initialGuess(float * pose, const Math::Vector3f & target)
+		{
+			::std::copy(m_lastPose.begin(), m_lastPose.end(), pose) ;
+			float velocity2 = m_targetVelocity.norm2() ;
+			if(!m_extrapolate || m_history<2 || velocity2==0.0f) { return ; }
+			// Ratio of the displacement of the target along its previous velocity (1 if the target keeps its velocity)
+			float ratio = ::std::max(0.0f, ::std::min(2.0f, ((target-m_lastTarget)*m_targetVelocity)/velocity2)) ;
+			if(ratio==0.0f) { return ; }
+			for(size_t dof=0 ; dof<m_guess.size() ; ++dof)
+			{
+				m_guess[dof] = m_chain->limits(int(dof)).clamp(m_lastPose[dof]+(m_lastPose[dof]-m_previousPose[dof])*ratio) ;
+			}
+			// The last pose reaches the last target (up to the tolerance)
+			m_chain->forwardKinematics(m_guess.data(), m_workspace) ;
+			float guessDistance = (target-m_chain->position(m_workspace, m_extremity, m_offset)).norm2() ;
+			if(guessDistance<(target-m_lastTarget).norm2()) { ::std::copy(m_guess.begin(), m_guess.end(), pose) ; }
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	WarmStartIK::WarmStartIK(const CompiledKinematicChain & chain, int extremity,
+		/// 	const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	chain	 	The compiled chain (must outlive this object).
+		/// \param	extremity	The index of the extremity in the compiled chain.
+		/// \param	offset   	(optional) The offset from the extremity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		WarmStartIK(const CompiledKinematicChain & chain, int extremity, const Math::Vector3f & offset = Math::makeVector(0.0f, 0.0f, 0.0f))
+			: m_chain(&chain), m_extremity(extremity), m_offset(offset), m_solver(chain, extremity, offset), m_workspace(chain),
+			  m_lastPose(chain.dofs()), m_previousPose(chain.dofs()), m_guess(chain.dofs()),
+			  m_lastTarget(Math::makeVector(0.0f, 0.0f, 0.0f)), m_targetVelocity(Math::makeVector(0.0f, 0.0f, 0.0f)),
+			  m_lastResidual(0.0f), m_history(0), m_skipTolerance(0.0f), m_extrapolate(true)
+		{}
+
+		/// \brief	Gets the solver (to configure it).
+		Solver & solver()
+		{
+			return m_solver ;
+		}
+
+		/// \brief	Sets the displacement of the target under which the last converged pose is reused.
+		void setSkipTolerance(float skipTolerance)
+		{
+			m_skipTolerance = skipTolerance ;
+		}
+
+		/// \brief	Enables / disables the extrapolation of the initial guess.
+		void setExtrapolation(bool extrapolate)
+		{
+			m_extrapolate = extrapolate ;
+		}
+
+		/// \brief	Forgets the converged poses (to call when the pose is modified by something else).
+		void reset()
+		{
+			m_history = 0 ;
+		}
+
+		const Statistics & statistics() const
+		{
+			return m_statistics ;
+		}
+
+		void resetStatistics()
+		{
+			m_statistics = Statistics() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Result WarmStartIK::solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations,
+		/// 	float tolerance)
+		///
+		/// \brief	Moves the extremity toward the target. If a converged pose is known, pose is replaced by
+		/// 		the initial guess before solving. When the solver is not run, the residual is an upper
+		/// 		bound (residual of the last pose plus the displacement of the target).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	pose		 	The pose (updated).
+		/// \param 		 	target		 	The target.
+		/// \param 		 	maxIterations	The maximum number of iterations.
+		/// \param 		 	tolerance	 	The distance under which the target is reached.
+		///
+		/// \return	The number of iterations and the residual.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Result solve(float * pose, const Math::Vector3f & target, unsigned int maxIterations, float tolerance)
+		{
+			Clock::time_point start = Clock::now() ;
+			++m_statistics.m_solves ;
+			Result result ;
+			bool skipped = false ;
+			if(m_history>0)
+			{
+				float moved = (target-m_lastTarget).norm() ;
+				result.m_residual = m_lastResidual+moved ;
+				if(moved<=m_skipTolerance && result.m_residual<=tolerance)
+				{
+					::std::copy(m_lastPose.begin(), m_lastPose.end(), pose) ;
+					result.m_converged = true ;
+					skipped = true ;
+					++m_statistics.m_skipped ;
+				}
+				else { initialGuess(pose, target) ; }
+			}
+			if(!skipped)
+			{
+				result = m_solver.solve(pose, target, maxIterations, tolerance) ;
+				if(result.m_converged)
+				{
+					m_previousPose.swap(m_lastPose) ;
+					::std::copy(pose, pose+m_lastPose.size(), m_lastPose.begin()) ;
+					m_targetVelocity = (m_history>0) ? target-m_lastTarget : Math::makeVector(0.0f, 0.0f, 0.0f) ;
+					m_lastTarget = target ;
+					m_lastResidual = result.m_residual ;
+					m_history = ::std::min(m_history+1, 2) ;
+				}
+				else { m_history = 0 ; }
+			}
+			if(result.m_converged) { ++m_statistics.m_converged ; }
+			m_statistics.m_iterations += result.m_iterations ;
+			m_statistics.m_seconds += ::std::chrono::duration<double>(Clock::now()-start).count() ;
+			return result ;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,6 @@
+#include <Animation/BatchInverseKinematics.h>
+
+namespace Animation
+{
+
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include <Animation/Fabrik.h>
+
+namespace Animation
+{
+
+}
\ No newline at end of file
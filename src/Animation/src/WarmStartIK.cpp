@@ -0,0 +1,6 @@
+#include <Animation/WarmStartIK.h>
+
+namespace Animation
+{
+
+}
\ No newline at end of file
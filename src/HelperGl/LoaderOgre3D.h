@@ -76,6 +76,64 @@ namespace HelperGl
 				{}
 			};
 
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \struct	Keyframe
+			///
+			/// \brief	A keyframe of a track, relative to the bind pose of the bone.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			struct Keyframe
+			{
+				/// \brief	The time (seconds).
+				float m_time ;
+				/// \brief	The translation added to the bind position.
+				Math::Vector3f m_translation ;
+				/// \brief	The rotation axis.
+				Math::Vector3f m_rotationAxis ;
+				/// \brief	The rotation angle.
+				float m_rotationAngle ;
+
+				Keyframe()
+					: m_time(0.0f), m_translation(0.0f), m_rotationAxis(0.0f), m_rotationAngle(0.0f)
+				{}
+			};
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \struct	Track
+			///
+			/// \brief	The keyframes of a bone (sorted by time).
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			struct Track
+			{
+				/// \brief	The name of the bone.
+				::std::string m_bone ;
+				/// \brief	The keyframes.
+				::std::vector<Keyframe> m_keyframes ;
+			};
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \struct	Animation
+			///
+			/// \brief	An animation of the skeleton.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			struct Animation
+			{
+				/// \brief	The name.
+				::std::string m_name ;
+				/// \brief	The length (seconds).
+				float m_length ;
+				/// \brief	The tracks (bones without track keep their bind pose).
+				::std::vector<Track> m_tracks ;
+			};
+
 		protected:
 			/// \brief	The bones.
 			::std::deque<Bone> m_bones ;
@@ -85,6 +143,8 @@ namespace HelperGl
 			::std::map<::std::string, Bone*> m_idToBone ;
 			/// \brief	Zero-based index of the identifier to bone.
 			::std::map<::std::string, unsigned int> m_idToBoneIndex ;
+			/// \brief	The animations.
+			::std::vector<Animation> m_animations ;
 
 		public:
 			////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -220,6 +280,75 @@ namespace HelperGl
 			{
 				return m_idToBoneIndex[id] ;
 			}
+
+			/// \brief	The number of bones.
+			size_t size() const
+			{
+				return m_bones.size() ;
+			}
+
+			/// \brief	The bone with the given index (order of the file).
+			const Bone & bone(size_t index) const
+			{
+				return m_bones[index] ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	int Skeleton::indexOf(::std::string const & id) const
+			///
+			/// \brief	Index of a bone given its identifier.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	id	The identifier.
+			///
+			/// \return	The index of the bone, -1 if there is no bone with this identifier.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			int indexOf(::std::string const & id) const
+			{
+				auto found = m_idToBoneIndex.find(id) ;
+				if(found==m_idToBoneIndex.end()) { return -1 ; }
+				return int(found->second) ;
+			}
+
+			/// \brief	Adds an animation.
+			void addAnimation(const Animation & animation)
+			{
+				m_animations.push_back(animation) ;
+			}
+
+			const ::std::vector<Animation> & animations() const
+			{
+				return m_animations ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	int Skeleton::indexOfName(::std::string const & name) const
+			///
+			/// \brief	Index of a bone given its name.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param	name	The name.
+			///
+			/// \return	The index of the bone, -1 if there is no bone with this name.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			int indexOfName(::std::string const & name) const
+			{
+				auto found = m_nameToBone.find(name) ;
+				if(found==m_nameToBone.end() || found->second==NULL) { return -1 ; }
+				return indexOf(found->second->m_id) ;
+			}
+
+			/// \brief	Index of the parent of a bone, -1 for a root.
+			int parentIndex(size_t index) const
+			{
+				const Bone * parent = m_bones[index].m_parent ;
+				if(parent==NULL) { return -1 ; }
+				return indexOf(parent->m_id) ;
+			}
 		};
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -275,6 +404,47 @@ namespace HelperGl
 			{}
 		};
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	BoneAssignment
+		///
+		/// \brief	The influence of a bone on a vertex (<vertexboneassignment> node of a mesh).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct BoneAssignment
+		{
+			/// \brief	The index of the vertex.
+			unsigned int m_vertex ;
+			/// \brief	The bone (identifier of the bone in the skeleton).
+			unsigned int m_bone ;
+			/// \brief	The weight.
+			float m_weight ;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	Mesh
+		///
+		/// \brief	A sub mesh described in a .mesh.xml file from Ogre.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Mesh
+		{
+			struct Face
+			{
+				unsigned int m_indexes[3] ;
+			};
+
+			::std::vector<Math::Vector3f> m_positions ;
+			::std::vector<Math::Vector3f> m_normals ;
+			::std::vector<Math::Vector2f> m_textureCoodinates ;
+			::std::vector<Face> m_faces ;
+			/// \brief	The bone assignments of the vertices (see Animation::Skinning).
+			::std::vector<BoneAssignment> m_boneAssignments ;
+		};
+
 	protected:
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -453,6 +623,70 @@ namespace HelperGl
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LoaderOgre3D::parseAnimations( rapidxml::xml_node<> * node, Skeleton * skeleton )
+		///
+		/// \brief	Parse the animations of a skeleton (the <animations> node is optional).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	node		The <skeleton> node.
+		/// \param [in,out]	skeleton	The skeleton.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void parseAnimations( rapidxml::xml_node<> * node, Skeleton * skeleton )
+		{
+			rapidxml::xml_node<> * animations = node->first_node("animations") ;
+			if(animations==NULL) { return ; }
+			rapidxml::xml_node<> * animationIterator = animations->first_node("animation") ;
+			while(animationIterator!=NULL)
+			{
+				Skeleton::Animation animation ;
+				rapidxml::xml_attribute<> * name = animationIterator->first_attribute("name") ;
+				notNull(name, "Missing name attribute in <animation> node") ;
+				animation.m_name = name->value() ;
+				rapidxml::xml_attribute<> * length = animationIterator->first_attribute("length") ;
+				notNull(length, "Missing length attribute in <animation> node") ;
+				animation.m_length = (float)atof(length->value()) ;
+				rapidxml::xml_node<> * tracks = animationIterator->first_node("tracks") ;
+				notNull(tracks, "Missing <tracks> node in <animation> node") ;
+				rapidxml::xml_node<> * trackIterator = tracks->first_node("track") ;
+				while(trackIterator!=NULL)
+				{
+					Skeleton::Track track ;
+					rapidxml::xml_attribute<> * bone = trackIterator->first_attribute("bone") ;
+					notNull(bone, "Missing bone attribute in <track> node") ;
+					track.m_bone = bone->value() ;
+					rapidxml::xml_node<> * keyframes = trackIterator->first_node("keyframes") ;
+					notNull(keyframes, "Missing <keyframes> node in <track> node") ;
+					rapidxml::xml_node<> * keyframeIterator = keyframes->first_node("keyframe") ;
+					while(keyframeIterator!=NULL)
+					{
+						Skeleton::Keyframe keyframe ;
+						rapidxml::xml_attribute<> * time = keyframeIterator->first_attribute("time") ;
+						notNull(time, "Missing time attribute in <keyframe> node") ;
+						keyframe.m_time = (float)atof(time->value()) ;
+						rapidxml::xml_node<> * translate = keyframeIterator->first_node("translate") ;
+						if(translate!=NULL) { keyframe.m_translation = parseVector3f(translate) ; }
+						rapidxml::xml_node<> * rotate = keyframeIterator->first_node("rotate") ;
+						if(rotate!=NULL)
+						{
+							keyframe.m_rotationAngle = parseAngle(rotate) ;
+							rapidxml::xml_node<> * axis = rotate->first_node("axis") ;
+							notNull(axis, "Missing <axis> node in <rotate> node") ;
+							keyframe.m_rotationAxis = parseVector3f(axis) ;
+						}
+						track.m_keyframes.push_back(keyframe) ;
+						keyframeIterator = keyframeIterator->next_sibling("keyframe") ;
+					}
+					animation.m_tracks.push_back(track) ;
+					trackIterator = trackIterator->next_sibling("track") ;
+				}
+				skeleton->addAnimation(animation) ;
+				animationIterator = animationIterator->next_sibling("animation") ;
+			}
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	Skeleton * LoaderOgre3D::parseSkeleton(rapidxml::xml_node<> * node) throw (MissingAttributeException,
 		/// 	MissingNodeException)
@@ -477,6 +711,8 @@ namespace HelperGl
 			parseBones(node, skeleton);
 			// Loads bones hierarchy
 			parseBonesHierarchy(node, skeleton);
+			// Loads animations
+			parseAnimations(node, skeleton);
 			return skeleton ;
 		}
 
@@ -496,7 +732,7 @@ namespace HelperGl
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Math::Vector3f parseVertex(rapidxml::xml_node<> * node, const ::std::string & subNodeName)
 		{
-			assert(::std::string(node->value())=="vertex") ;
+			assert(::std::string(node->name())=="vertex") ;
 			Math::Vector3f result;
 			rapidxml::xml_node<> * subNode = node->first_node(subNodeName.c_str()) ;
 			notNull(subNode, ::std::string("Missing ")+subNodeName+" node");
@@ -517,7 +753,7 @@ namespace HelperGl
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		::std::vector<Math::Vector3f> parseVertexBuffer(rapidxml::xml_node<> * node, const ::std::string & subNodeName)
 		{
-			assert(::std::string(node->value())=="vertexbuffer") ;
+			assert(::std::string(node->name())=="vertexbuffer") ;
 			::std::vector<Math::Vector3f> buffer ;
 			rapidxml::xml_node<> * vertex_iterator = node->first_node("vertex") ;
 			while(vertex_iterator!=NULL)
@@ -530,7 +766,7 @@ namespace HelperGl
 
 		::std::vector<Math::Vector2f> parseTextureCoordinatesBuffer(rapidxml::xml_node<> * node)
 		{
-			assert(::std::string(node->value())=="vertexbuffer") ;
+			assert(::std::string(node->name())=="vertexbuffer") ;
 			::std::vector<Math::Vector2f> buffer ;
 			rapidxml::xml_node<> * vertex_iterator = node->first_node("vertex") ;
 			while(vertex_iterator!=NULL)
@@ -548,7 +784,7 @@ namespace HelperGl
 							   bool & hasNormals, ::std::vector<Math::Vector3f> & normals,
 							   bool & hasTextureCoordinates, ::std::vector<Math::Vector2f> & textureCoodinates)
 		{
-			assert(::std::string(node->value())=="vertexbuffer") ;
+			assert(::std::string(node->name())=="vertexbuffer") ;
 			hasPositions = false ;
 			hasNormals = false ;
 			hasTextureCoordinates = false ;
@@ -568,26 +804,25 @@ namespace HelperGl
 			if(textureAttrib!=NULL)
 			{
 				hasTextureCoordinates = true ;
-				parseTextureCoordinatesBuffer(node) ;
+				textureCoodinates = parseTextureCoordinatesBuffer(node) ;
 			}
 		}
 
-		struct Mesh
-		{
-			struct Face
-			{
-				unsigned int m_indexes[3] ;
-			};
-
-			::std::vector<Math::Vector3f> m_positions ;
-			::std::vector<Math::Vector3f> m_normals ;
-			::std::vector<Math::Vector2f> m_textureCoodinates ;
-			::std::vector<Face> m_faces ;
-		};
-
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LoaderOgre3D::parseGeometry(rapidxml::xml_node<> * node, Mesh & mesh)
+		///
+		/// \brief	Parse a <geometry> or <sharedgeometry> node (the attributes of the vertices may be
+		/// 		split in several vertex buffers).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	node	The geometry node.
+		/// \param [in,out]	mesh	The mesh receiving the vertices.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
 		void parseGeometry(rapidxml::xml_node<> * node, Mesh & mesh)
 		{
-			assert(::std::string(node->value())=="geometry") ;
+			assert(::std::string(node->name())=="geometry" || ::std::string(node->name())=="sharedgeometry") ;
 			rapidxml::xml_node<> * bufferIterator = node->first_node("vertexbuffer") ;
 			bool hasPositions ;
 			bool hasNormals ; 
@@ -595,31 +830,32 @@ namespace HelperGl
 
 			while(bufferIterator!=NULL)
 			{
-				parseVertexBuffer(node, hasPositions, mesh.m_positions, hasNormals, mesh.m_normals, hasTextureCoordinates, mesh.m_textureCoodinates) ;
+				parseVertexBuffer(bufferIterator, hasPositions, mesh.m_positions, hasNormals, mesh.m_normals, hasTextureCoordinates, mesh.m_textureCoodinates) ;
+				bufferIterator = bufferIterator->next_sibling("vertexbuffer") ;
 			}
 		}
 
 		Mesh::Face parseFace(rapidxml::xml_node<> * node)
 		{
-			assert(::std::string(node->value())=="face") ;
+			assert(::std::string(node->name())=="face") ;
 			Mesh::Face face ;
 			rapidxml::xml_attribute<> * v1 = node->first_attribute("v1") ;
 			notNull(v1, "Missing v1 attribute!") ;
 			rapidxml::xml_attribute<> * v2 = node->first_attribute("v2") ;
 			notNull(v2, "Missing v2 attribute!") ;
 			rapidxml::xml_attribute<> * v3 = node->first_attribute("v3") ;
-			notNull(v2, "Missing v3 attribute!") ;
+			notNull(v3, "Missing v3 attribute!") ;
 
-			face.m_indexes[0] = atof(v1->value()) ;
-			face.m_indexes[1] = atof(v2->value()) ;
-			face.m_indexes[2] = atof(v3->value()) ;
+			face.m_indexes[0] = (unsigned int)atoi(v1->value()) ;
+			face.m_indexes[1] = (unsigned int)atoi(v2->value()) ;
+			face.m_indexes[2] = (unsigned int)atoi(v3->value()) ;
 
 			return face ;
 		}
 
 		void parseFaces(rapidxml::xml_node<> * node, Mesh & mesh)
 		{
-			assert(::std::string(node->value())=="faces") ;
+			assert(::std::string(node->name())=="faces") ;
 			rapidxml::xml_node<> * faceIterator = node->first_node("face") ;
 			while(faceIterator!=NULL)
 			{
@@ -628,9 +864,36 @@ namespace HelperGl
 			}
 		}
 
-		void parseBoneAssignment(rapidxml::xml_node<> * node)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LoaderOgre3D::parseBoneAssignment(rapidxml::xml_node<> * node, Mesh & mesh)
+		///
+		/// \brief	Parse the <vertexboneassignment> nodes of a <boneassignments> node.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	node	The <boneassignments> node.
+		/// \param [in,out]	mesh	The mesh receiving the assignments.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void parseBoneAssignment(rapidxml::xml_node<> * node, Mesh & mesh)
 		{
-			assert(::std::string(node->value())=="boneassignments") ;
+			assert(::std::string(node->name())=="boneassignments") ;
+			rapidxml::xml_node<> * assignmentIterator = node->first_node("vertexboneassignment") ;
+			while(assignmentIterator!=NULL)
+			{
+				BoneAssignment assignment ;
+				rapidxml::xml_attribute<> * vertex = assignmentIterator->first_attribute("vertexindex") ;
+				notNull(vertex, "Missing vertexindex attribute in <vertexboneassignment> node!") ;
+				rapidxml::xml_attribute<> * bone = assignmentIterator->first_attribute("boneindex") ;
+				notNull(bone, "Missing boneindex attribute in <vertexboneassignment> node!") ;
+				rapidxml::xml_attribute<> * weight = assignmentIterator->first_attribute("weight") ;
+				notNull(weight, "Missing weight attribute in <vertexboneassignment> node!") ;
+				assignment.m_vertex = (unsigned int)atoi(vertex->value()) ;
+				assignment.m_bone = (unsigned int)atoi(bone->value()) ;
+				assignment.m_weight = (float)atof(weight->value()) ;
+				mesh.m_boneAssignments.push_back(assignment) ;
+				assignmentIterator = assignmentIterator->next_sibling("vertexboneassignment") ;
+			}
 		}
 
 	public:
@@ -653,6 +916,62 @@ namespace HelperGl
 			doc.parse<0>(xmlFile.data());
 			return parseSkeleton(doc.first_node("skeleton")) ;
 		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	::std::vector<Mesh> LoaderOgre3D::loadMesh(const ::std::string & filename)
+		/// 	throw (MissingAttributeException, MissingNodeException)
+		///
+		/// \brief	Loads a mesh file (.mesh.xml). Each sub mesh has its own vertices: the sub meshes
+		/// 		using the shared geometry receive a copy of it and of the bone assignments of the
+		/// 		mesh. The bone assignments can be given to Animation::Skinning with the skeleton
+		/// 		loaded by loadSkeleton.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	filename	Filename of the file.
+		///
+		/// \return	The sub meshes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		::std::vector<Mesh> loadMesh(const ::std::string & filename) throw (MissingAttributeException, MissingNodeException)
+		{
+			rapidxml::file<> xmlFile(filename.c_str()); 
+			rapidxml::xml_document<> doc;
+			doc.parse<0>(xmlFile.data());
+			rapidxml::xml_node<> * meshNode = doc.first_node("mesh") ;
+			notNull(meshNode, "Missing <mesh> node!") ;
+			// Shared geometry and its bone assignments
+			Mesh shared ;
+			rapidxml::xml_node<> * sharedGeometry = meshNode->first_node("sharedgeometry") ;
+			if(sharedGeometry!=NULL) { parseGeometry(sharedGeometry, shared) ; }
+			rapidxml::xml_node<> * sharedAssignments = meshNode->first_node("boneassignments") ;
+			if(sharedAssignments!=NULL) { parseBoneAssignment(sharedAssignments, shared) ; }
+			// Sub meshes
+			::std::vector<Mesh> result ;
+			rapidxml::xml_node<> * subMeshes = meshNode->first_node("submeshes") ;
+			notNull(subMeshes, "Missing <submeshes> node!") ;
+			rapidxml::xml_node<> * subMeshIterator = subMeshes->first_node("submesh") ;
+			while(subMeshIterator!=NULL)
+			{
+				Mesh mesh ;
+				rapidxml::xml_attribute<> * useShared = subMeshIterator->first_attribute("usesharedvertices") ;
+				if(useShared!=NULL && ::std::string(useShared->value())=="true") { mesh = shared ; }
+				else
+				{
+					rapidxml::xml_node<> * geometry = subMeshIterator->first_node("geometry") ;
+					notNull(geometry, "Missing <geometry> node in <submesh> node!") ;
+					parseGeometry(geometry, mesh) ;
+					rapidxml::xml_node<> * assignments = subMeshIterator->first_node("boneassignments") ;
+					if(assignments!=NULL) { parseBoneAssignment(assignments, mesh) ; }
+				}
+				rapidxml::xml_node<> * faces = subMeshIterator->first_node("faces") ;
+				notNull(faces, "Missing <faces> node in <submesh> node!") ;
+				parseFaces(faces, mesh) ;
+				result.push_back(mesh) ;
+				subMeshIterator = subMeshIterator->next_sibling("submesh") ;
+			}
+			return result ;
+		}
 	};
 }
 
@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <stdlib.h>
+#include <Math/RandomGenerator.h>
 
 namespace Math
 {
@@ -331,8 +332,24 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Float random() const
 		{
-			Float value = Float(rand())/Float(RAND_MAX) ;
-			return value * delta() + inf() ;
+			return random(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Float random(RandomGenerator & generator) const
+		///
+		/// \brief	Returns a random value lying in the interval, using the provided generator. 
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	a random value lying in the interval. 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Float random(RandomGenerator & generator) const
+		{
+			return generator.unit<Float>() * delta() + inf() ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+#ifndef _Math_Ldlt_H
+#define _Math_Ldlt_H
+
+#include <cassert>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	template <class Float> bool ldltDecompose(Float * matrix, int size)
+	///
+	/// \brief	In place LDLt decomposition of a symmetric positive definite matrix (row major, size x size).
+	/// 		On return, the strict lower part contains L (unit diagonal) and the diagonal contains D.
+	/// 		The strict upper part is not used. No memory is allocated.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \tparam	Float	Type of the scalars.
+	/// \param [in,out]	matrix	The matrix.
+	/// \param 		 	size  	The size of the matrix.
+	///
+	/// \return	false if a pivot is not strictly positive (the matrix is not positive definite).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <class Float>
+	bool ldltDecompose(Float * matrix, int size)
+	{
+		for(int j=0 ; j<size ; ++j)
+		{
+			Float * rowJ = matrix+j*size ;
+			Float pivot = rowJ[j] ;
+			for(int k=0 ; k<j ; ++k) { pivot -= rowJ[k]*rowJ[k]*matrix[k*size+k] ; }
+			if(!(pivot>Float(0))) { return false ; }
+			rowJ[j] = pivot ;
+			for(int i=j+1 ; i<size ; ++i)
+			{
+				Float * rowI = matrix+i*size ;
+				Float value = rowI[j] ;
+				for(int k=0 ; k<j ; ++k) { value -= rowI[k]*rowJ[k]*matrix[k*size+k] ; }
+				rowI[j] = value/pivot ;
+			}
+		}
+		return true ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	template <class Float> void ldltSolve(const Float * decomposition, Float * vector, int size)
+	///
+	/// \brief	Solves A.x = vector in place, decomposition being the result of ldltDecompose(A).
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \tparam	Float	Type of the scalars.
+	/// \param 		 	decomposition	The decomposition.
+	/// \param [in,out]	vector		 	The right hand side, receives the solution.
+	/// \param 		 	size		 	The size of the system.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <class Float>
+	void ldltSolve(const Float * decomposition, Float * vector, int size)
+	{
+		// L.y = b
+		for(int i=0 ; i<size ; ++i)
+		{
+			for(int k=0 ; k<i ; ++k) { vector[i] -= decomposition[i*size+k]*vector[k] ; }
+		}
+		// D.z = y
+		for(int i=0 ; i<size ; ++i) { vector[i] /= decomposition[i*size+i] ; }
+		// Lt.x = z
+		for(int i=size-1 ; i>=0 ; --i)
+		{
+			for(int k=i+1 ; k<size ; ++k) { vector[i] -= decomposition[k*size+i]*vector[k] ; }
+		}
+	}
+}
+
+#endif
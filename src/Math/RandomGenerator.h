@@ -0,0 +1,318 @@
+#ifndef _Math_RandomGenerator_H
+#define _Math_RandomGenerator_H
+
+#include <cstdint>
+#include <atomic>
+#include <limits>
+#include <cstddef>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RandomGenerator
+	///
+	/// \brief	Pseudo random number generator (xoshiro128**). Unlike rand(), a generator has no shared
+	/// 		state: each thread or each task should use its own generator. A generator is
+	/// 		deterministically initialized from a seed and a stream index, generators initialized
+	/// 		with the same seed and different streams produce independent sequences. This class
+	/// 		satisfies the UniformRandomBitGenerator requirements and can be used with the standard
+	/// 		distributions.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RandomGenerator
+	{
+	public:
+		typedef ::std::uint32_t result_type ;
+
+	protected:
+		/// \brief	The state of the generator.
+		::std::uint32_t m_state[4] ;
+
+		static ::std::uint32_t rotl(::std::uint32_t x, int k)
+		{
+			return (x << k) | (x >> (32 - k)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static ::std::uint64_t RandomGenerator::splitMix(::std::uint64_t & x)
+		///
+		/// \brief	SplitMix64 generator, used to initialize the state from the seed and the stream.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	x	The state of the SplitMix64 generator.
+		///
+		/// \return	The next value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static ::std::uint64_t splitMix(::std::uint64_t & x)
+		{
+			::std::uint64_t z = (x += 0x9e3779b97f4a7c15ull) ;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull ;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull ;
+			return z ^ (z >> 31) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RandomGenerator::RandomGenerator(::std::uint64_t seed = 0, ::std::uint64_t stream = 0)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	seed  	(optional) the seed.
+		/// \param	stream	(optional) the stream index.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		explicit RandomGenerator(::std::uint64_t seed = 0, ::std::uint64_t stream = 0)
+		{
+			this->seed(seed, stream) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RandomGenerator::seed(::std::uint64_t seed, ::std::uint64_t stream = 0)
+		///
+		/// \brief	Reinitializes the generator.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	seed  	The seed.
+		/// \param	stream	(optional) the stream index.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void seed(::std::uint64_t seed, ::std::uint64_t stream = 0)
+		{
+			::std::uint64_t x = splitMix(seed) ^ (stream * 0xd1342543de82ef95ull) ;
+			::std::uint64_t a = splitMix(x) ;
+			::std::uint64_t b = splitMix(x) ;
+			m_state[0] = (::std::uint32_t)a ;
+			m_state[1] = (::std::uint32_t)(a >> 32) ;
+			m_state[2] = (::std::uint32_t)b ;
+			m_state[3] = (::std::uint32_t)(b >> 32) ;
+			if((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0) { m_state[0] = 1 ; } // The null state is forbidden
+		}
+
+		static constexpr result_type min() { return 0 ; }
+
+		static constexpr result_type max() { return ::std::numeric_limits<result_type>::max() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	result_type RandomGenerator::operator()()
+		///
+		/// \brief	Generates the next 32 bits random value.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	A random value in [0;2^32-1].
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		result_type operator() ()
+		{
+			const ::std::uint32_t result = rotl(m_state[1] * 5, 7) * 9 ;
+			const ::std::uint32_t t = m_state[1] << 9 ;
+			m_state[2] ^= m_state[0] ;
+			m_state[3] ^= m_state[1] ;
+			m_state[1] ^= m_state[2] ;
+			m_state[0] ^= m_state[3] ;
+			m_state[2] ^= t ;
+			m_state[3] = rotl(m_state[3], 11) ;
+			return result ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float RandomGenerator::random()
+		///
+		/// \brief	Returns a random float uniformly distributed in [0;1).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	A random float.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float random()
+		{
+			return float((*this)() >> 8) * (1.0f / 16777216.0f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	double RandomGenerator::randomDouble()
+		///
+		/// \brief	Returns a random double uniformly distributed in [0;1) (53 bits of precision).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	A random double.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		double randomDouble()
+		{
+			::std::uint64_t high = (*this)() >> 5 ;
+			::std::uint64_t low = (*this)() >> 6 ;
+			return double((high << 26) | low) * (1.0 / 9007199254740992.0) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class Float> Float RandomGenerator::unit()
+		///
+		/// \brief	Returns a random value uniformly distributed in [0;1) with the precision of type Float.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \tparam	Float	Type of the scalar.
+		///
+		/// \return	A random value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class Float>
+		Float unit()
+		{
+			return Float(randomDouble()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static ::std::uint64_t RandomGenerator::newStream()
+		///
+		/// \brief	Returns a new stream index. Stream indexes are allocated in increasing order, the
+		/// 		result is deterministic if streams are allocated in a deterministic order. Thread local
+		/// 		generators do not use these indexes (see threadLocal()).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	A stream index that has not been returned before.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static ::std::uint64_t newStream()
+		{
+			static ::std::atomic<::std::uint64_t> counter(1) ;
+			return counter++ ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static RandomGenerator & RandomGenerator::threadLocal()
+		///
+		/// \brief	Gets the generator of the calling thread. Each thread owns a generator initialized with
+		/// 		its own stream on first use. These streams have the high bit set and are counted
+		/// 		separately from newStream(): the streams returned by newStream() do not depend on the
+		/// 		threads that used a thread local generator. This generator is used by the functions of
+		/// 		Sampler and Interval when no generator is provided. When reproducibility is needed
+		/// 		across threads, use explicitly seeded generators.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The generator of the calling thread.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static RandomGenerator & threadLocal()
+		{
+			static ::std::atomic<::std::uint64_t> counter(0) ;
+			static thread_local RandomGenerator generator(0, (::std::uint64_t(1) << 63) | counter++) ;
+			return generator ;
+		}
+	};
+
+	template <>
+	inline float RandomGenerator::unit<float>()
+	{
+		return random() ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RandomLanes
+	///
+	/// \brief	Eight interleaved xoshiro128** generators used to fill arrays of random values. The 
+	/// 		states are stored lane by lane so that the eight generators are updated by the same 
+	/// 		instructions (the update loop is vectorized by the compiler). The lanes are seeded from
+	/// 		a RandomGenerator, the produced sequence is deterministic.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RandomLanes
+	{
+	public:
+		enum { lanes = 8 } ;
+
+	protected:
+		/// \brief	The states of the generators, m_state[i][lane] is the i-th word of the state of the lane.
+		::std::uint32_t m_state[4][lanes] ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RandomLanes::RandomLanes(RandomGenerator & generator)
+		///
+		/// \brief	Constructor. The lanes are initialized with values drawn from generator.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The generator used for initialization.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		explicit RandomLanes(RandomGenerator & generator)
+		{
+			for(int lane=0 ; lane<lanes ; ++lane)
+			{
+				do
+				{
+					for(int word=0 ; word<4 ; ++word) { m_state[word][lane] = generator() ; }
+				} while((m_state[0][lane] | m_state[1][lane] | m_state[2][lane] | m_state[3][lane]) == 0) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RandomLanes::random(float * output, size_t count)
+		///
+		/// \brief	Fills output with count random floats uniformly distributed in [0;1).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [out]	output	The output array.
+		/// \param	count		  	The number of values.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void random(float * output, size_t count)
+		{
+			::std::uint32_t s0[lanes], s1[lanes], s2[lanes], s3[lanes] ;
+			for(int lane=0 ; lane<lanes ; ++lane) 
+			{
+				s0[lane] = m_state[0][lane] ; s1[lane] = m_state[1][lane] ; 
+				s2[lane] = m_state[2][lane] ; s3[lane] = m_state[3][lane] ;
+			}
+			float values[lanes] ;
+			for(size_t begin=0 ; begin<count ; begin+=lanes)
+			{
+				for(int lane=0 ; lane<lanes ; ++lane)
+				{
+					::std::uint32_t x = s1[lane]*5 ;
+					::std::uint32_t result = ((x << 7) | (x >> 25))*9 ;
+					::std::uint32_t t = s1[lane] << 9 ;
+					s2[lane] ^= s0[lane] ;
+					s3[lane] ^= s1[lane] ;
+					s1[lane] ^= s2[lane] ;
+					s0[lane] ^= s3[lane] ;
+					s2[lane] ^= t ;
+					s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21) ;
+					// 24 bits values are converted as signed integers (faster conversion)
+					values[lane] = float(::std::int32_t(result >> 8)) * (1.0f / 16777216.0f) ;
+				}
+				if(count-begin>=(size_t)lanes)
+				{
+					for(int lane=0 ; lane<lanes ; ++lane) { output[begin+lane] = values[lane] ; }
+				}
+				else
+				{
+					for(size_t lane=0 ; lane<count-begin ; ++lane) { output[begin+lane] = values[lane] ; }
+				}
+			}
+			for(int lane=0 ; lane<lanes ; ++lane) 
+			{
+				m_state[0][lane] = s0[lane] ; m_state[1][lane] = s1[lane] ; 
+				m_state[2][lane] = s2[lane] ; m_state[3][lane] = s3[lane] ;
+			}
+		}
+	};
+}
+
+#endif
@@ -5,6 +5,10 @@
 #include <Math/Quaternion.h>
 #include <Math/Interval.h>
 #include <Math/Interpolation.h>
+#include <Math/RandomGenerator.h>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
 #define _USE_MATH_DEFINES
 #include <math.h>
 
@@ -34,7 +38,24 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static float random()
 		{
-			return (float)rand()/RAND_MAX ;
+			return random(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static float Sampler::random(RandomGenerator & generator)
+		///
+		/// \brief	Returns a random float in interval [0;1) using the provided generator.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static float random(RandomGenerator & generator)
+		{
+			return generator.random() ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,13 +70,31 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static Math::Vector3f ball()
 		{
-			Math::Interval<float> generator(-1.0f,1.0f) ;
+			return ball(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector3f Sampler::ball(RandomGenerator & generator)
+		///
+		/// \brief	Returns a random point in the unit ball using the provided generator. Distribution is 
+		/// 		uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector3f ball(RandomGenerator & generator)
+		{
+			Math::Interval<float> interval(-1.0f,1.0f) ;
 			float a,b,c ;
 			do
 			{
-				a = generator.random() ;
-				b = generator.random() ;
-				c = generator.random() ;
+				a = interval.random(generator) ;
+				b = interval.random(generator) ;
+				c = interval.random(generator) ;
 			}
 			while(a*a+b*b+c*c>1) ;
 			return Math::makeVector(a,b,c) ;
@@ -73,12 +112,30 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static Math::Vector3f sphere()
 		{
-			Math::Interval<float> generator(-1.0f,1.0f) ;
+			return sphere(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector3f Sampler::sphere(RandomGenerator & generator)
+		///
+		/// \brief	Returns a random point on the surface of the unit sphere using the provided generator. 
+		/// 		Distribution is uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	A random point on the surface of the unit sphere.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector3f sphere(RandomGenerator & generator)
+		{
+			Math::Interval<float> interval(-1.0f,1.0f) ;
 			float x1,x2 ;
 			do 
 			{
-				x1 = generator.random() ;
-				x2 = generator.random() ;
+				x1 = interval.random(generator) ;
+				x2 = interval.random(generator) ;
 			} while (x1*x1+x2*x2>=1.0f);
 			float tmp = sqrt(1.0f-x1*x1-x2*x2) ;
 			return Math::makeVector(2.0f*x1*tmp, 2.0f*x2*tmp, 1.0f-2.0f*(x1*x1+x2*x2)) ;
@@ -96,8 +153,28 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static Math::Vector3f cube()
 		{
-			Math::Interval<float> interval(0,1) ;
-			return Math::makeVector(interval.random(), interval.random(), interval.random()) ;
+			return cube(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector3f Sampler::cube(RandomGenerator & generator)
+		///
+		/// \brief	Gets a random point in a unit cube (0,1) using the provided generator. Distribution is 
+		/// 		uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector3f cube(RandomGenerator & generator)
+		{
+			float x = generator.random() ;
+			float y = generator.random() ;
+			float z = generator.random() ;
+			return Math::makeVector(x, y, z) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,8 +189,26 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static Math::Vector2f disk()
 		{
-			float angle = Math::Interval<float>(-(float)M_PI, (float)M_PI).random() ;
-			float radius = sqrt(Math::Interval<float>(0.0f,1.0f).random()) ;
+			return disk(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector2f Sampler::disk(RandomGenerator & generator)
+		///
+		/// \brief	Returns a random point inside the unit disk using the provided generator. Distribution
+		/// 		is uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	A random point inside the unit disk.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector2f disk(RandomGenerator & generator)
+		{
+			float angle = Math::Interval<float>(-(float)M_PI, (float)M_PI).random(generator) ;
+			float radius = sqrt(generator.random()) ;
 			return makeVector(radius*cos(angle), radius*sin(angle)) ;
 		}
 
@@ -129,18 +224,231 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		static Math::Vector2f circle()
 		{
-			Math::Interval<float> generator(-1.0f,1.0f) ;
+			return circle(RandomGenerator::threadLocal()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static Math::Vector2f Sampler::circle(RandomGenerator & generator)
+		///
+		/// \brief	Returns a random point on the unit circle using the provided generator.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static Math::Vector2f circle(RandomGenerator & generator)
+		{
+			Math::Interval<float> interval(-1.0f,1.0f) ;
 			float x1,x2 ;
 			do 
 			{
-				x1 = generator.random() ;
-				x2 = generator.random() ;
+				x1 = interval.random(generator) ;
+				x2 = interval.random(generator) ;
 			} while (x1*x1+x2*x2>=1.0f);
 			float x1_2 = x1*x1 ;
 			float x2_2 = x2*x2 ;
 			return Math::makeVector((x1_2-x2_2)/(x1_2+x2_2), (2.0f*x1*x2)/(x1_2+x2_2)) ;
 		}
 
+		// -------------------------------------------------------------------------------
+		// Batch sampling: samples are generated by chunks, random values are produced first
+		// then transformed without rejection nor branches so that loops can be vectorized.
+		// -------------------------------------------------------------------------------
+
+		/// \brief	The number of samples processed by chunk in batch sampling functions.
+		enum { batchChunkSize = 256 } ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::random(RandomGenerator & generator, float * output, size_t count)
+		///
+		/// \brief	Fills output with count random floats in [0;1). Values are produced by RandomLanes 
+		/// 		seeded from generator.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		/// \param [out]	output   	The output array (count floats).
+		/// \param	count			 	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void random(RandomGenerator & generator, float * output, size_t count)
+		{
+			RandomLanes lanes(generator) ;
+			lanes.random(output, count) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::sinCos2Pi(const float * t, float * sinValues, float * cosValues, size_t count)
+		///
+		/// \brief	Computes sin(2*pi*t) and cos(2*pi*t) for t in [0;1]. Branch free polynomial 
+		/// 		approximation (absolute error lower than 5e-6) suitable for vectorization.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	t					The values in [0;1].
+		/// \param [out]	sinValues	The sines.
+		/// \param [out]	cosValues	The cosines.
+		/// \param	count				The number of values.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void sinCos2Pi(const float * t, float * sinValues, float * cosValues, size_t count)
+		{
+			const float pi = (float)M_PI ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				// 2*pi*t = x + pi with x in [-pi;pi] 
+				float x = (t[cpt]-0.5f)*2.0f*pi ;
+				// y = |x| - pi/2 is in [-pi/2;pi/2], sin(x) = sign(x)*cos(y) and cos(x) = -sin(y)
+				float y = fabsf(x)-0.5f*pi ;
+				float y2 = y*y ;
+				float s = y*(1.0f+y2*(-1.0f/6.0f+y2*(1.0f/120.0f+y2*(-1.0f/5040.0f+y2*(1.0f/362880.0f))))) ;
+				float c = 1.0f+y2*(-0.5f+y2*(1.0f/24.0f+y2*(-1.0f/720.0f+y2*(1.0f/40320.0f+y2*(-1.0f/3628800.0f))))) ;
+				// sin(x+pi) = -sin(x), cos(x+pi) = -cos(x)
+				sinValues[cpt] = -copysignf(c, x) ;
+				cosValues[cpt] = s ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::sphere(RandomGenerator & generator, Math::Vector3f * output, size_t count)
+		///
+		/// \brief	Fills output with count random points on the surface of the unit sphere. Distribution 
+		/// 		is uniform (z is uniform in [-1;1], the azimuth is uniform in [0;2pi]).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		/// \param [out]	output   	The output array (count points).
+		/// \param	count			 	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void sphere(RandomGenerator & generator, Math::Vector3f * output, size_t count)
+		{
+			RandomLanes lanes(generator) ;
+			float u[batchChunkSize], v[batchChunkSize], sinValues[batchChunkSize], cosValues[batchChunkSize] ;
+			for(size_t begin=0 ; begin<count ; begin+=batchChunkSize)
+			{
+				size_t size = ::std::min((size_t)batchChunkSize, count-begin) ;
+				lanes.random(u, size) ;
+				lanes.random(v, size) ;
+				sinCos2Pi(v, sinValues, cosValues, size) ;
+				Math::Vector3f * chunk = output+begin ;
+				for(size_t cpt=0 ; cpt<size ; ++cpt)
+				{
+					float z = 1.0f-2.0f*u[cpt] ;
+					float r = sqrtf(::std::max(0.0f, 1.0f-z*z)) ;
+					chunk[cpt][0] = r*cosValues[cpt] ;
+					chunk[cpt][1] = r*sinValues[cpt] ;
+					chunk[cpt][2] = z ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::ball(RandomGenerator & generator, Math::Vector3f * output, size_t count)
+		///
+		/// \brief	Fills output with count random points in the unit ball. Distribution is uniform (a 
+		/// 		point on the sphere scaled by the cubic root of a uniform value).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		/// \param [out]	output   	The output array (count points).
+		/// \param	count			 	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void ball(RandomGenerator & generator, Math::Vector3f * output, size_t count)
+		{
+			sphere(generator, output, count) ;
+			RandomLanes lanes(generator) ;
+			float u[batchChunkSize] ;
+			for(size_t begin=0 ; begin<count ; begin+=batchChunkSize)
+			{
+				size_t size = ::std::min((size_t)batchChunkSize, count-begin) ;
+				lanes.random(u, size) ;
+				Math::Vector3f * chunk = output+begin ;
+				for(size_t cpt=0 ; cpt<size ; ++cpt)
+				{
+					// Cubic root of a value in (0;1]: initial guess by bit manipulation and 3 Newton iterations
+					float x = 1.0f-u[cpt] ;
+					::std::uint32_t bits ;
+					::std::memcpy(&bits, &x, sizeof(float)) ;
+					bits = bits/3+709921077u ;
+					float r ;
+					::std::memcpy(&r, &bits, sizeof(float)) ;
+					r = r-(r*r*r-x)/(3.0f*r*r) ;
+					r = r-(r*r*r-x)/(3.0f*r*r) ;
+					r = r-(r*r*r-x)/(3.0f*r*r) ;
+					chunk[cpt] *= r ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::disk(RandomGenerator & generator, Math::Vector2f * output, size_t count)
+		///
+		/// \brief	Fills output with count random points inside the unit disk. Distribution is uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		/// \param [out]	output   	The output array (count points).
+		/// \param	count			 	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void disk(RandomGenerator & generator, Math::Vector2f * output, size_t count)
+		{
+			RandomLanes lanes(generator) ;
+			float u[batchChunkSize], v[batchChunkSize], sinValues[batchChunkSize], cosValues[batchChunkSize] ;
+			for(size_t begin=0 ; begin<count ; begin+=batchChunkSize)
+			{
+				size_t size = ::std::min((size_t)batchChunkSize, count-begin) ;
+				lanes.random(u, size) ;
+				lanes.random(v, size) ;
+				sinCos2Pi(v, sinValues, cosValues, size) ;
+				Math::Vector2f * chunk = output+begin ;
+				for(size_t cpt=0 ; cpt<size ; ++cpt)
+				{
+					float r = sqrtf(u[cpt]) ;
+					chunk[cpt][0] = r*cosValues[cpt] ;
+					chunk[cpt][1] = r*sinValues[cpt] ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Sampler::circle(RandomGenerator & generator, Math::Vector2f * output, size_t count)
+		///
+		/// \brief	Fills output with count random points on the unit circle. Distribution is uniform.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param [in,out]	generator	The random generator.
+		/// \param [out]	output   	The output array (count points).
+		/// \param	count			 	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void circle(RandomGenerator & generator, Math::Vector2f * output, size_t count)
+		{
+			RandomLanes lanes(generator) ;
+			float u[batchChunkSize], sinValues[batchChunkSize], cosValues[batchChunkSize] ;
+			for(size_t begin=0 ; begin<count ; begin+=batchChunkSize)
+			{
+				size_t size = ::std::min((size_t)batchChunkSize, count-begin) ;
+				lanes.random(u, size) ;
+				sinCos2Pi(u, sinValues, cosValues, size) ;
+				Math::Vector2f * chunk = output+begin ;
+				for(size_t cpt=0 ; cpt<size ; ++cpt)
+				{
+					chunk[cpt][0] = cosValues[cpt] ;
+					chunk[cpt][1] = sinValues[cpt] ;
+				}
+			}
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \class	Hemisphere
 		///
@@ -154,19 +462,20 @@ namespace Math
 		{
 		protected:
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			/// \fn	static ::std::pair<float,float> Hemisphere::randomPolar(float n=1.0)
+			/// \fn	static ::std::pair<float,float> Hemisphere::randomPolar(RandomGenerator & generator, float n=1.0)
 			///
 			/// \brief	Static constructor.
 			///
 			/// \author	F. Lamarche, Universit de Rennes 1
 			/// \date	17/12/2015
 			///
+			/// \param [in,out]	generator	The random generator.
 			/// \param	n	(optional) the  float to process.
 			////////////////////////////////////////////////////////////////////////////////////////////////////
-			static ::std::pair<float,float> randomPolar(float n=1.0)
+			static ::std::pair<float,float> randomPolar(RandomGenerator & generator, float n=1.0)
 			{
-				float theta = acos(pow(random(), 1/(n+1))) ;
-				float phy = 2.0f*(float)M_PI*random() ;
+				float theta = acos(pow(random(generator), 1/(n+1))) ;
+				float phy = 2.0f*(float)M_PI*random(generator) ;
 				return ::std::make_pair(theta, phy) ;
 			}
 
@@ -240,7 +549,24 @@ namespace Math
 			////////////////////////////////////////////////////////////////////////////////////////////////////
 			Math::Vector3f generate() const
 			{
-				::std::pair<float,float> perturbation = randomPolar(m_n) ;
+				return generate(RandomGenerator::threadLocal()) ;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	Math::Vector3f Hemisphere::generate(RandomGenerator & generator) const
+			///
+			/// \brief	Generates a random direction using the provided generator.
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param [in,out]	generator	The random generator.
+			///
+			/// \return	The random direction.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			Math::Vector3f generate(RandomGenerator & generator) const
+			{
+				::std::pair<float,float> perturbation = randomPolar(generator, m_n) ;
 				Quaternion<float> q1(m_directionNormal, perturbation.first) ;
 				Quaternion<float> q2(m_direction, perturbation.second) ;
 				return (q2*q1).rotate(m_direction) ;
@@ -248,6 +574,55 @@ namespace Math
 				//Math::Quaternion<float> result = q2.rotate(q1.rotate(m_direction)) ;
 				//return result.v() ;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// \fn	void Hemisphere::generate(RandomGenerator & generator, Math::Vector3f * output, size_t count) const
+			///
+			/// \brief	Fills output with count random directions. The directions are directly computed in the
+			/// 		frame associated with the privileged direction (no quaternion, no trigonometric 
+			/// 		function call) and the distribution is the same as the one of generate().
+			///
+			/// \author	F. Lamarche, Universit de Rennes 1
+			/// \date	18/10/2026
+			///
+			/// \param [in,out]	generator	The random generator.
+			/// \param [out]	output   	The output array (count directions).
+			/// \param	count			 	The number of samples.
+			////////////////////////////////////////////////////////////////////////////////////////////////////
+			void generate(RandomGenerator & generator, Math::Vector3f * output, size_t count) const
+			{
+				const Math::Vector3f normal = m_directionNormal.normalized() ;
+				const Math::Vector3f binormal = m_direction^normal ;
+				const float exponent = 1.0f/(m_n+1.0f) ;
+				RandomLanes lanes(generator) ;
+				float cosTheta[batchChunkSize], v[batchChunkSize], sinValues[batchChunkSize], cosValues[batchChunkSize] ;
+				for(size_t begin=0 ; begin<count ; begin+=batchChunkSize)
+				{
+					size_t size = ::std::min((size_t)batchChunkSize, count-begin) ;
+					lanes.random(cosTheta, size) ;
+					lanes.random(v, size) ;
+					if(m_n==1.0f) // Diffuse surface
+					{
+						for(size_t cpt=0 ; cpt<size ; ++cpt) { cosTheta[cpt] = sqrtf(cosTheta[cpt]) ; }
+					}
+					else if(m_n!=0.0f) // Specular surface (uniform sampling if m_n==0)
+					{
+						for(size_t cpt=0 ; cpt<size ; ++cpt) { cosTheta[cpt] = powf(cosTheta[cpt], exponent) ; }
+					}
+					sinCos2Pi(v, sinValues, cosValues, size) ;
+					Math::Vector3f * chunk = output+begin ;
+					for(size_t cpt=0 ; cpt<size ; ++cpt)
+					{
+						float c = cosTheta[cpt] ;
+						float s = sqrtf(::std::max(0.0f, 1.0f-c*c)) ;
+						float a = s*cosValues[cpt] ;
+						float b = s*sinValues[cpt] ;
+						chunk[cpt][0] = normal[0]*a+binormal[0]*b+m_direction[0]*c ;
+						chunk[cpt][1] = normal[1]*a+binormal[1]*b+m_direction[1]*c ;
+						chunk[cpt][2] = normal[2]*a+binormal[2]*b+m_direction[2]*c ;
+					}
+				}
+			}
 		};
 	};
 }
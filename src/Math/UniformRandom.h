@@ -1,22 +1,27 @@
 #pragma once
-#include <random>
+#include <Math/RandomGenerator.h>
+#include <cstdint>
 #include <cassert>
 
 namespace Math
-{	
+{
 	/// <summary>
-	/// Uniform random number generator based on mersen twister algorithm
+	/// Uniform random number generator based on the xoshiro128** algorithm (see <see cref="RandomGenerator"/>)
 	/// </summary>
 	class UniformRandom
 	{
-		mutable std::mt19937_64 m_generator;
+		mutable RandomGenerator m_generator;
 
-	public:		
+	public:
 		/// <summary>
 		/// Initializes a new instance of the <see cref="UniformRandom"/> class.
 		/// </summary>
-		UniformRandom() {}
-		
+		/// <param name="seed">The seed.</param>
+		/// <param name="stream">The stream index, instances with different streams produce independent sequences.</param>
+		UniformRandom(std::uint64_t seed = 0, std::uint64_t stream = 0)
+			: m_generator(seed, stream)
+		{}
+
 		/// <summary>
 		/// Generates a random number in the interval [min,max].
 		/// </summary>
@@ -26,8 +31,16 @@ namespace Math
 		double operator() (double min, double max) const
 		{
 			assert(min <= max);
-			std::uniform_real_distribution<> distribution;
-			return distribution(m_generator)*(max-min)+min;
+			return m_generator.randomDouble()*(max-min)+min;
+		}
+
+		/// <summary>
+		/// Gets the underlying generator.
+		/// </summary>
+		/// <returns>The generator.</returns>
+		RandomGenerator & generator() const
+		{
+			return m_generator;
 		}
 	};
-}
\ No newline at end of file
+}
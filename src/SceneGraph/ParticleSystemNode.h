@@ -3,13 +3,30 @@
 
 #include <SceneGraph/PointRenderer.h>
 #include <Animation/ParticleSystem.h>
+#include <Utils/RadixSort.h>
+#include <GL/compatibility.h>
+#include <gl3/ViewFrustum.h>
+#include <gl3/BoundingBox.h>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/combinable.h>
 
 namespace SceneGraph
 {
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// \class	ParticleSystemNode
 	///
-	/// \brief	Node displaying a particle system. 
+	/// \brief	Node displaying a particle system. By default, particles are uploaded from back to front
+	/// 		(sorted on their depth in the current model view) for alpha blended rendering.
+	/// 		Before upload, particles outside the view frustum are culled (by blocks of particles
+	/// 		then individually) and distant particles can be stochastically thinned (level of detail).
+	/// 		The fraction of visible particles can be fed back to the particle system as an effective
+	/// 		budget, lowering the emission of particle systems that are out of view.
 	///
 	/// \author	F. Lamarche, Universit de Rennes 1
 	/// \date	04/04/2016
@@ -19,18 +36,467 @@ namespace SceneGraph
 	protected:
 		Animation::ParticleSystem * m_particleSystem ;
 
+		/// \brief	true if particles are sorted on depth before upload.
+		bool m_depthSort ;
+		/// \brief	The drawing order of the particles (indexes in the particle system), kept between frames
+		/// 		as the identifiers of the particles (see Animation::ParticleSystem::identifiers).
+		::std::vector<::std::uint32_t> m_order ;
+		/// \brief	The quantized depths of the particles (in the order m_order).
+		::std::vector<::std::uint32_t> m_depthKeys ;
+		/// \brief	The radix sorter.
+		Utils::RadixSort m_sorter ;
+		/// \brief	Number of particles in the order (i.e. at the previous frame).
+		size_t m_orderSize ;
+
+		/// \brief	true if particles outside the view frustum are not drawn.
+		bool m_culling ;
+		/// \brief	Distance beyond which particles are thinned (0 disables the level of detail).
+		float m_lodDistance ;
+		/// \brief	Minimum probability of keeping a distant particle.
+		float m_lodMinimumDensity ;
+		/// \brief	true if the effective budget of the particle system is driven by the visibility.
+		bool m_budgetFeedback ;
+		/// \brief	Minimum ratio of the budget kept when the particle system is not visible.
+		float m_minimumBudgetRatio ;
+		/// \brief	Smoothed ratio of the budget fed back to the particle system.
+		float m_budgetRatio ;
+		/// \brief	Per particle flags: 0 not drawn, 1 drawn, 2 drawn and already in the order.
+		::std::vector<unsigned char> m_drawFlags ;
+		/// \brief	The view frustum in the local coordinate system of the particles.
+		gl3::ViewFrustum m_frustum ;
+
+		/// \brief	Number of bits of the quantized depths.
+		enum { depthBits = 16 } ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static glm::mat4 ParticleSystemNode::toGlm(const Math::Matrix4x4f & matrix)
+		///
+		/// \brief	Converts a matrix to glm (column major) format.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static glm::mat4 toGlm(const Math::Matrix4x4f & matrix)
+		{
+			glm::mat4 result ;
+			for(int row=0 ; row<4 ; ++row)
+			{
+				for(int column=0 ; column<4 ; ++column)
+				{
+					result[column][row] = matrix(row, column) ;
+				}
+			}
+			return result ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static float ParticleSystemNode::lodThreshold(::std::uint32_t identifier)
+		///
+		/// \brief	Pseudo random value in [0;1) associated to a particle identifier (see
+		/// 		Animation::ParticleSystem::identifiers). The same particles are kept from frame to
+		/// 		frame by the level of detail (no flickering).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static float lodThreshold(::std::uint32_t identifier)
+		{
+			::std::uint32_t h = identifier*0x9e3779b9u ;
+			h = (h ^ (h >> 16)) * 0x7feb352du ;
+			h = (h ^ (h >> 15)) * 0x846ca68bu ;
+			h ^= h >> 16 ;
+			return float(h >> 8) * (1.0f / 16777216.0f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::updateDrawFlags(const Math::Matrix4x4f & modelView, const Math::Matrix4x4f & projection, size_t & visible, size_t & drawn)
+		///
+		/// \brief	Computes the draw flag of each particle. For each block of particles, the bounding box
+		/// 		of the block is tested against the view frustum: blocks outside the frustum are
+		/// 		rejected, blocks inside the frustum are accepted, the particles of the other blocks
+		/// 		are tested individually. Visible particles farther than the LOD distance d are kept
+		/// 		with probability max((d/depth)^2, minimum density), the number of particles per
+		/// 		pixel stays roughly constant.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	modelView 		The model view matrix.
+		/// \param	projection		The projection matrix.
+		/// \param [out]	visible	The number of particles inside the view frustum.
+		/// \param [out]	drawn  	The number of particles to draw (visible particles kept by the LOD).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void updateDrawFlags(const Math::Matrix4x4f & modelView, const Math::Matrix4x4f & projection, size_t & visible, size_t & drawn)
+		{
+			Animation::ParticleSystem::ConstParticleRange particles = m_particleSystem->getParticles() ;
+			const size_t size = particles.size() ;
+			const size_t grainSize = m_particleSystem->grainSize() ;
+			const size_t blocks = (size+grainSize-1)/grainSize ;
+			unsigned char * flags = m_drawFlags.data() ;
+			const gl3::ViewFrustum & frustum = m_frustum ;
+			m_frustum.setProjectionAndViewMatrices(toGlm(projection), toGlm(modelView)) ;
+			const bool culling = m_culling ;
+			const Math::Vector4f depthRow = Math::makeVector(modelView(2,0), modelView(2,1), modelView(2,2), modelView(2,3)) ;
+			const float lodDistance = m_lodDistance ;
+			const float minimumDensity = m_lodMinimumDensity ;
+			const ::std::uint32_t * identifiers = m_particleSystem->identifiers() ;
+			::tbb::combinable<::std::pair<size_t, size_t>> counts([]() { return ::std::make_pair((size_t)0, (size_t)0) ; }) ;
+			::tbb::parallel_for((size_t)0, blocks, [&particles, &frustum, &depthRow, &counts, flags, identifiers, size, grainSize, culling, lodDistance, minimumDensity](size_t block)
+			{
+				const size_t begin = block*grainSize ;
+				const size_t end = ::std::min(begin+grainSize, size) ;
+				// Block level culling
+				bool testParticles = false ;
+				if(culling)
+				{
+					gl3::BoundingBox box ;
+					for(size_t cpt=begin ; cpt<end ; ++cpt)
+					{
+						const Math::Vector3f & position = particles[cpt].m_position ;
+						box.update(glm::vec3(position[0], position[1], position[2])) ;
+					}
+					// Boxes of a single point are empty, they are inflated a little
+					box = gl3::BoundingBox(box.min()-glm::vec3(1e-6f), box.max()+glm::vec3(1e-6f)) ;
+					if(!frustum.intersects(box))
+					{
+						::std::fill(flags+begin, flags+end, (unsigned char)0) ;
+						return ;
+					}
+					testParticles = !frustum.contains(box) ;
+				}
+				// Particle level culling and level of detail
+				size_t localVisible = 0 ;
+				size_t localDrawn = 0 ;
+				for(size_t cpt=begin ; cpt<end ; ++cpt)
+				{
+					const Math::Vector3f & position = particles[cpt].m_position ;
+					unsigned char flag = !testParticles || frustum.intersects(glm::vec3(position[0], position[1], position[2])) ;
+					localVisible += flag ;
+					if(flag && lodDistance>0.0f)
+					{
+						float depth = -(depthRow[0]*position[0]+depthRow[1]*position[1]+depthRow[2]*position[2]+depthRow[3]) ;
+						if(depth>lodDistance)
+						{
+							float ratio = lodDistance/depth ;
+							flag = lodThreshold(identifiers[cpt]) < ::std::max(ratio*ratio, minimumDensity) ;
+						}
+					}
+					flags[cpt] = flag ;
+					localDrawn += flag ;
+				}
+				::std::pair<size_t, size_t> & local = counts.local() ;
+				local.first += localVisible ;
+				local.second += localDrawn ;
+			}) ;
+			::std::pair<size_t, size_t> total = counts.combine([](const ::std::pair<size_t, size_t> & a, const ::std::pair<size_t, size_t> & b)
+				{ return ::std::make_pair(a.first+b.first, a.second+b.second) ; }) ;
+			visible = total.first ;
+			drawn = total.second ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::updateBudget(size_t visible)
+		///
+		/// \brief	Feeds the fraction of visible particles back to the particle system as an effective
+		/// 		budget. The ratio increases immediately when particles become visible and decreases
+		/// 		slowly, a particle system does not starve when the camera looks away for a few frames.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	visible	The number of particles inside the view frustum.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void updateBudget(size_t visible)
+		{
+			const size_t size = m_particleSystem->getParticles().size() ;
+			if(size==0) { return ; } // Nothing to measure, the previous budget is kept
+			float ratio = ::std::max(float(visible)/float(size), m_minimumBudgetRatio) ;
+			m_budgetRatio = ::std::max(ratio, m_budgetRatio*0.95f) ;
+			m_particleSystem->setEffectiveBudget((size_t)::std::ceil(m_budgetRatio*m_particleSystem->budget())) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	size_t ParticleSystemNode::updateOrder(const Math::Matrix4x4f & modelView)
+		///
+		/// \brief	Computes the back to front order of the drawn particles (see m_drawFlags). The order
+		/// 		of the previous frame is used as input (particles killed or not drawn anymore are
+		/// 		removed, other particles are appended, see m_order). Particle depths change a little between frames so this order is nearly
+		/// 		sorted: if it is sorted, nothing is done, if it contains few inversions, it is fixed
+		/// 		by an insertion sort with a bounded number of moves. Otherwise the quantized depths
+		/// 		are sorted with the parallel radix sort.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	modelView	The model view matrix.
+		///
+		/// \return	The number of drawn particles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		size_t updateOrder(const Math::Matrix4x4f & modelView)
+		{
+			Animation::ParticleSystem::ConstParticleRange particles = m_particleSystem->getParticles() ;
+			const size_t particleCount = particles.size() ;
+			const size_t grainSize = m_particleSystem->grainSize() ;
+			unsigned char * flags = m_drawFlags.data() ;
+			// The previous order contains identifiers, they are converted to the current indexes
+			const ::std::uint32_t * identifiers = m_particleSystem->identifiers() ;
+			if(m_orderSize>0)
+			{
+				::std::uint32_t * indexes = m_depthKeys.data() ; // The keys are recomputed below
+				const size_t budget = m_particleSystem->budget() ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, budget, grainSize), [identifiers, indexes](const ::tbb::blocked_range<size_t> & range)
+				{
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt) { indexes[identifiers[cpt]] = (::std::uint32_t)cpt ; }
+				}) ;
+				::std::uint32_t * order = m_order.data() ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, m_orderSize, grainSize), [indexes, order](const ::tbb::blocked_range<size_t> & range)
+				{
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt) { order[cpt] = indexes[order[cpt]] ; }
+				}) ;
+			}
+			// Previous order, the indexes of the particles that are not drawn anymore are removed
+			size_t current = 0 ;
+			for(size_t cpt=0 ; cpt<m_orderSize ; ++cpt)
+			{
+				::std::uint32_t index = m_order[cpt] ;
+				if(index<particleCount && flags[index]==1) { m_order[current] = index ; flags[index] = 2 ; ++current ; }
+			}
+			// Newly drawn particles are appended
+			for(size_t cpt=0 ; cpt<particleCount ; ++cpt)
+			{
+				if(flags[cpt]==1) { m_order[current] = (::std::uint32_t)cpt ; ++current ; }
+			}
+			const size_t size = current ;
+			m_orderSize = size ;
+			if(size==0) { return 0 ; }
+			// Depth range (only the third row of the model view is needed)
+			const Math::Vector4f depthRow = Math::makeVector(modelView(2,0), modelView(2,1), modelView(2,2), modelView(2,3)) ;
+			const ::std::uint32_t * order = m_order.data() ;
+			::tbb::combinable<::std::pair<float, float>> ranges([]() { return ::std::make_pair(::std::numeric_limits<float>::max(), -::std::numeric_limits<float>::max()) ; }) ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, grainSize), [&particles, &depthRow, &ranges, order](const ::tbb::blocked_range<size_t> & range)
+			{
+				::std::pair<float, float> & local = ranges.local() ;
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Math::Vector3f & position = particles[order[cpt]].m_position ;
+					float depth = depthRow[0]*position[0]+depthRow[1]*position[1]+depthRow[2]*position[2]+depthRow[3] ;
+					local.first = ::std::min(local.first, depth) ;
+					local.second = ::std::max(local.second, depth) ;
+				}
+			}) ;
+			::std::pair<float, float> depthRange = ranges.combine([](const ::std::pair<float, float> & a, const ::std::pair<float, float> & b)
+				{ return ::std::make_pair(::std::min(a.first, b.first), ::std::max(a.second, b.second)) ; }) ;
+			// Quantized depths in the previous order, the farthest particles (lowest z) come first
+			const float maxKey = float((1<<depthBits)-1) ;
+			const float scale = (depthRange.second>depthRange.first) ? maxKey/(depthRange.second-depthRange.first) : 0.0f ;
+			const float offset = depthRange.first ;
+			::std::uint32_t * keys = m_depthKeys.data() ;
+			::tbb::combinable<size_t> descents([]() { return (size_t)0 ; }) ;
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, grainSize), [&particles, &depthRow, &descents, keys, order, scale, offset, maxKey](const ::tbb::blocked_range<size_t> & range)
+			{
+				size_t localDescents = 0 ;
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					const Math::Vector3f & position = particles[order[cpt]].m_position ;
+					float depth = depthRow[0]*position[0]+depthRow[1]*position[1]+depthRow[2]*position[2]+depthRow[3] ;
+					keys[cpt] = (::std::uint32_t)::std::min((depth-offset)*scale, maxKey) ;
+				}
+				for(size_t cpt=::std::max<size_t>(range.begin(), 1) ; cpt!=range.end() ; ++cpt)
+				{
+					localDescents += (keys[cpt]<keys[cpt-1]) ;
+				}
+				descents.local() += localDescents ;
+			}) ;
+			// The descents between blocks are not counted, the insertion sort fixes them
+			size_t descentCount = descents.combine([](size_t a, size_t b) { return a+b ; }) ;
+			if(descentCount<size/64 && insertionSort(size, 8*size)) { return size ; }
+			m_sorter.sort(keys, size, (::std::uint32_t)maxKey) ;
+			const ::std::uint32_t * permutation = m_sorter.permutation() ;
+			::std::uint32_t * sortedOrder = m_depthKeys.data() ; // The keys are not used anymore
+			::tbb::parallel_for(::tbb::blocked_range<size_t>(0, size, grainSize), [permutation, order, sortedOrder](const ::tbb::blocked_range<size_t> & range)
+			{
+				for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+				{
+					sortedOrder[cpt] = order[permutation[cpt]] ;
+				}
+			}) ;
+			m_order.swap(m_depthKeys) ;
+			return size ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool ParticleSystemNode::insertionSort(size_t size, size_t maxMoves)
+		///
+		/// \brief	Insertion sort of the order given the depth keys. The sort is stopped when maxMoves
+		/// 		moves have been done (the order is still a permutation of the particles).
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	size		The number of particles.
+		/// \param	maxMoves	The maximum number of moves.
+		///
+		/// \return	true if the order is sorted, false if the sort has been stopped.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool insertionSort(size_t size, size_t maxMoves)
+		{
+			::std::uint32_t * keys = m_depthKeys.data() ;
+			::std::uint32_t * order = m_order.data() ;
+			size_t moves = 0 ;
+			for(size_t cpt=1 ; cpt<size ; ++cpt)
+			{
+				::std::uint32_t key = keys[cpt] ;
+				if(keys[cpt-1]<=key) { continue ; }
+				::std::uint32_t index = order[cpt] ;
+				size_t position = cpt ;
+				for( ; position>0 && keys[position-1]>key ; --position, ++moves)
+				{
+					keys[position] = keys[position-1] ;
+					order[position] = order[position-1] ;
+				}
+				keys[position] = key ;
+				order[position] = index ;
+				if(moves>maxMoves) { return false ; }
+			}
+			return true ;
+		}
+
 	public:
-		ParticleSystemNode(Animation::ParticleSystem * particleSystem, float particleSize=1.0f)
+		ParticleSystemNode(Animation::ParticleSystem * particleSystem, float particleSize=1.0f, bool depthSort=true)
 			: SceneGraph::PointRenderer(new HelperGl::Buffer<Math::Vector3f>(particleSystem->budget(), HelperGl::Buffer<Math::Vector3f>::ArrayBuffer), particleSize,
 			new HelperGl::Buffer<HelperGl::Color>(particleSystem->budget(), HelperGl::Buffer<HelperGl::Color>::ArrayBuffer)
 			),
-			m_particleSystem(particleSystem)
-		{}
+			m_particleSystem(particleSystem), m_depthSort(depthSort), m_order(particleSystem->budget()), m_depthKeys(particleSystem->budget()),
+			m_orderSize(0), m_culling(true), m_lodDistance(0.0f), m_lodMinimumDensity(0.05f), m_budgetFeedback(false), m_minimumBudgetRatio(0.1f),
+			m_budgetRatio(1.0f), m_drawFlags(particleSystem->budget())
+		{
+			m_sorter.reserve(particleSystem->budget()) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::setDepthSort(bool depthSort)
+		///
+		/// \brief	Enables / disables the back to front sort of the particles.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	depthSort	true to sort the particles on depth before upload.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setDepthSort(bool depthSort)
+		{
+			m_depthSort = depthSort ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::setCulling(bool culling)
+		///
+		/// \brief	Enables / disables the view frustum culling of the particles.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	culling	true to skip the particles outside the view frustum.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setCulling(bool culling)
+		{
+			m_culling = culling ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::setLod(float distance, float minimumDensity = 0.05f)
+		///
+		/// \brief	Sets the level of detail. Particles farther than distance are kept with a probability
+		/// 		decreasing with the square of their depth. As all particles are drawn with the same
+		/// 		point size, the size is scaled by sqrt(visible / drawn): the area covered by the
+		/// 		particles is preserved on average.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	distance	  	The distance beyond which particles are thinned (0 disables the LOD).
+		/// \param	minimumDensity	(optional) the minimum probability of keeping a particle.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setLod(float distance, float minimumDensity = 0.05f)
+		{
+			m_lodDistance = ::std::max(distance, 0.0f) ;
+			m_lodMinimumDensity = ::std::min(::std::max(minimumDensity, 0.0f), 1.0f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ParticleSystemNode::setBudgetFeedback(bool enabled, float minimumRatio = 0.1f)
+		///
+		/// \brief	Enables / disables the feedback of the visibility to the effective budget of the
+		/// 		particle system. When enabled, the effective budget is the budget scaled by the
+		/// 		fraction of particles inside the view frustum (at least minimumRatio). When disabled,
+		/// 		the effective budget is reset to the budget.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	enabled			true to drive the effective budget by the visibility.
+		/// \param	minimumRatio	(optional) the ratio of the budget kept when the system is out of view.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setBudgetFeedback(bool enabled, float minimumRatio = 0.1f)
+		{
+			m_budgetFeedback = enabled ;
+			m_minimumBudgetRatio = ::std::min(::std::max(minimumRatio, 0.0f), 1.0f) ;
+			m_budgetRatio = 1.0f ;
+			if(!enabled) { m_particleSystem->setEffectiveBudget(m_particleSystem->budget()) ; }
+		}
 
 		virtual void draw()
 		{
 			setPointCount(m_particleSystem->getParticles().size()) ;
 			//m_particleSystem->update(0.001) ;
+			const bool filter = m_culling || m_lodDistance>0.0f || m_budgetFeedback ;
+			float pointSizeScale = 1.0f ;
+			if(m_depthSort || filter)
+			{
+				Animation::ParticleSystem::ConstParticleRange particles = m_particleSystem->getParticles() ;
+				Math::Matrix4x4f modelView = GL::getModelViewMatrix() ;
+				size_t visible = particles.size() ;
+				size_t drawn = particles.size() ;
+				if(filter) { updateDrawFlags(modelView, GL::getProjectionMatrix(), visible, drawn) ; }
+				else { ::std::fill(m_drawFlags.begin(), m_drawFlags.begin()+particles.size(), (unsigned char)1) ; }
+				if(m_budgetFeedback) { updateBudget(visible) ; }
+				if(drawn>0) { pointSizeScale = ::std::sqrt(float(visible)/float(drawn)) ; }
+				if(m_depthSort) { updateOrder(modelView) ; }
+				else
+				{
+					// Storage order
+					size_t current = 0 ;
+					for(size_t cpt=0 ; cpt<particles.size() ; ++cpt)
+					{
+						if(m_drawFlags[cpt]) { m_order[current] = (::std::uint32_t)cpt ; ++current ; }
+					}
+					m_orderSize = current ;
+				}
+				assert(m_orderSize==drawn) ;
+				setPointCount(drawn) ;
+				// Drawn particles are directly written in the upload buffers
+				Math::Vector3f * positions = &(*m_positionBuffer)[0] ;
+				HelperGl::Color * colors = &(*m_colorBuffer)[0] ;
+				// The order is kept for the next frame with the identifiers of the particles (see m_order)
+				::std::uint32_t * order = m_order.data() ;
+				const ::std::uint32_t * identifiers = m_particleSystem->identifiers() ;
+				::tbb::parallel_for(::tbb::blocked_range<size_t>(0, drawn, m_particleSystem->grainSize()), [&particles, positions, colors, order, identifiers](const ::tbb::blocked_range<size_t> & range)
+				{
+					for(size_t cpt=range.begin() ; cpt!=range.end() ; ++cpt)
+					{
+						const Animation::Particle & particle = particles[order[cpt]] ;
+						positions[cpt] = particle.m_position ;
+						colors[cpt] = particle.m_color ;
+						order[cpt] = identifiers[order[cpt]] ;
+					}
+				}) ;
+				if(drawn>0)
+				{
+					m_positionBuffer->updateBuffer(0, drawn) ;
+					m_colorBuffer->updateBuffer(0, drawn) ;
+				}
+			}
+			else
 			{
 				auto itBuffer = m_positionBuffer->begin() ;
 				auto itColor = m_colorBuffer->begin() ;
@@ -44,7 +510,10 @@ namespace SceneGraph
 				m_positionBuffer->updateBuffer(0, m_particleSystem->getParticles().size()) ;
 				m_colorBuffer->updateBuffer(0, m_particleSystem->getParticles().size()) ;
 			}
+			const float pointSize = m_pointSize ;
+			m_pointSize *= pointSizeScale ;
 			SceneGraph::PointRenderer::draw() ;
+			m_pointSize = pointSize ;
 
 		}
 	};
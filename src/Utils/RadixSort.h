@@ -0,0 +1,195 @@
+#ifndef _Utils_RadixSort_H
+#define _Utils_RadixSort_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <tbb/parallel_for.h>
+
+namespace Utils
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RadixSort
+	///
+	/// \brief	Parallel LSD radix sort of 32 bits keys (8 bits per pass). The sort is stable and
+	/// 		computes the permutation that sorts the keys: after sort(), permutation()[i] is the
+	/// 		index (in the input array) of the i-th smallest key. Each pass computes the histogram
+	/// 		of each block of keys in parallel, the prefix sum over (digit, block) gives the
+	/// 		destination of each block, keys are then scattered in parallel. Passes on digits
+	/// 		that are the same for all the keys are skipped. The buffers are kept between calls,
+	/// 		sorting arrays of similar sizes does not allocate memory.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RadixSort
+	{
+	public:
+		enum { digitBits = 8, digits = 1<<digitBits } ;
+
+	protected:
+		/// \brief	Double buffered keys.
+		::std::vector<::std::uint32_t> m_keys[2] ;
+		/// \brief	Double buffered permutation.
+		::std::vector<::std::uint32_t> m_indexes[2] ;
+		/// \brief	Histograms (then destination offsets) of each block, m_histograms[block*digits+digit].
+		::std::vector<size_t> m_histograms ;
+		/// \brief	Index of the buffer containing the result.
+		int m_result ;
+		/// \brief	The number of keys processed by a task.
+		size_t m_grainSize ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RadixSort::RadixSort(size_t grainSize = 8192)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	grainSize	(optional) the number of keys processed by a task.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RadixSort(size_t grainSize = 8192)
+			: m_result(0), m_grainSize(::std::max<size_t>(grainSize, 1))
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RadixSort::reserve(size_t size)
+		///
+		/// \brief	Reserves the buffers for sorting up to size keys.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	size	The number of keys.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reserve(size_t size)
+		{
+			for(int cpt=0 ; cpt<2 ; ++cpt)
+			{
+				m_keys[cpt].reserve(size) ;
+				m_indexes[cpt].reserve(size) ;
+			}
+			m_histograms.reserve(((size+m_grainSize-1)/m_grainSize)*digits) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RadixSort::sort(const ::std::uint32_t * keys, size_t size, ::std::uint32_t maxKey = 0xffffffff)
+		///
+		/// \brief	Sorts the keys. The sorted keys and the permutation are available through keys() and
+		/// 		permutation() until the next call.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \param	keys  	The keys.
+		/// \param	size  	The number of keys.
+		/// \param	maxKey	(optional) an upper bound of the keys, only the digits needed to encode
+		/// 				maxKey are sorted.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void sort(const ::std::uint32_t * keys, size_t size, ::std::uint32_t maxKey = 0xffffffff)
+		{
+			for(int cpt=0 ; cpt<2 ; ++cpt)
+			{
+				m_keys[cpt].resize(size) ;
+				m_indexes[cpt].resize(size) ;
+			}
+			const size_t grainSize = m_grainSize ;
+			const size_t blocks = (size+grainSize-1)/grainSize ;
+			m_histograms.resize(blocks*digits) ;
+			::std::uint32_t * sourceKeys = m_keys[0].data() ;
+			::std::uint32_t * sourceIndexes = m_indexes[0].data() ;
+			::tbb::parallel_for((size_t)0, blocks, [keys, sourceKeys, sourceIndexes, size, grainSize](size_t block)
+			{
+				size_t end = ::std::min(block*grainSize+grainSize, size) ;
+				for(size_t cpt=block*grainSize ; cpt<end ; ++cpt)
+				{
+					sourceKeys[cpt] = keys[cpt] ;
+					sourceIndexes[cpt] = (::std::uint32_t)cpt ;
+				}
+			}) ;
+			m_result = 0 ;
+			size_t * histograms = m_histograms.data() ;
+			for(int shift=0 ; shift<32 && (shift==0 || (maxKey>>shift)!=0) ; shift+=digitBits)
+			{
+				const ::std::uint32_t * inKeys = m_keys[m_result].data() ;
+				const ::std::uint32_t * inIndexes = m_indexes[m_result].data() ;
+				::std::uint32_t * outKeys = m_keys[1-m_result].data() ;
+				::std::uint32_t * outIndexes = m_indexes[1-m_result].data() ;
+				// Histogram of each block
+				::tbb::parallel_for((size_t)0, blocks, [inKeys, histograms, size, grainSize, shift](size_t block)
+				{
+					size_t * histogram = histograms+block*digits ;
+					::std::fill(histogram, histogram+digits, (size_t)0) ;
+					size_t end = ::std::min(block*grainSize+grainSize, size) ;
+					for(size_t cpt=block*grainSize ; cpt<end ; ++cpt)
+					{
+						++histogram[(inKeys[cpt]>>shift)&(digits-1)] ;
+					}
+				}) ;
+				// Exclusive prefix sum in (digit, block) order
+				size_t offset = 0 ;
+				bool skip = false ;
+				for(size_t digit=0 ; digit<digits ; ++digit)
+				{
+					size_t total = 0 ;
+					for(size_t block=0 ; block<blocks ; ++block)
+					{
+						size_t count = histograms[block*digits+digit] ;
+						histograms[block*digits+digit] = offset ;
+						offset += count ;
+						total += count ;
+					}
+					if(total==size) { skip = true ; break ; } // All the keys share this digit
+				}
+				if(skip) { continue ; }
+				// Scattering
+				::tbb::parallel_for((size_t)0, blocks, [inKeys, inIndexes, outKeys, outIndexes, histograms, size, grainSize, shift](size_t block)
+				{
+					size_t * destination = histograms+block*digits ;
+					size_t end = ::std::min(block*grainSize+grainSize, size) ;
+					for(size_t cpt=block*grainSize ; cpt<end ; ++cpt)
+					{
+						size_t index = destination[(inKeys[cpt]>>shift)&(digits-1)]++ ;
+						outKeys[index] = inKeys[cpt] ;
+						outIndexes[index] = inIndexes[cpt] ;
+					}
+				}) ;
+				m_result = 1-m_result ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::uint32_t * RadixSort::keys() const
+		///
+		/// \brief	Gets the sorted keys.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The sorted keys.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::uint32_t * keys() const
+		{
+			return m_keys[m_result].data() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::uint32_t * RadixSort::permutation() const
+		///
+		/// \brief	Gets the permutation: permutation()[i] is the index of the i-th key in the input array.
+		///
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	18/10/2026
+		///
+		/// \return	The permutation.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::uint32_t * permutation() const
+		{
+			return m_indexes[m_result].data() ;
+		}
+	};
+}
+
+#endif
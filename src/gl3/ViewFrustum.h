@@ -1,7 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <cassert>
 #include <glm/matrix.hpp>
+#include <glm/geometric.hpp>
+#include <gl3/BoundingBox.h>
 
 namespace gl3
 {
@@ -14,10 +17,37 @@ namespace gl3
 		glm::mat4 m_projectionMatrix;
 		glm::mat4 m_viewMatrix;
 		glm::mat4 m_inverseProjectionView;
+		glm::vec4 m_planes[6];
 
 		void updateMatrices()
 		{
-			m_inverseProjectionView = glm::inverse(m_projectionMatrix*m_viewMatrix);
+			glm::mat4 projectionView = m_projectionMatrix*m_viewMatrix;
+			m_inverseProjectionView = glm::inverse(projectionView);
+			updatePlanes(projectionView);
+		}
+
+		/// <summary>
+		/// Extracts the planes of the frustum from the projection view matrix (Gribb / Hartmann). Each plane
+		/// is normalized and oriented toward the inside of the frustum.
+		/// </summary>
+		/// <param name="projectionView">The projection view matrix.</param>
+		void updatePlanes(const glm::mat4 & projectionView)
+		{
+			glm::vec4 rows[4];
+			for (int row = 0; row < 4; ++row)
+			{
+				rows[row] = glm::vec4(projectionView[0][row], projectionView[1][row], projectionView[2][row], projectionView[3][row]);
+			}
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				m_planes[2 * axis] = rows[3] + rows[axis];
+				m_planes[2 * axis + 1] = rows[3] - rows[axis];
+			}
+			for (int cpt = 0; cpt < 6; ++cpt)
+			{
+				float norm = glm::length(glm::vec3(m_planes[cpt]));
+				if (norm > 0.0f) { m_planes[cpt] = m_planes[cpt] / norm; }
+			}
 		}
 
 	public:
@@ -25,6 +55,7 @@ namespace gl3
 		/// Initializes a new instance of the <see cref="ViewFrustum"/> class.
 		/// </summary>
 		ViewFrustum()
+			: m_projectionMatrix(1.0f), m_viewMatrix(1.0f)
 		{
 			for (int x = -1; x <= 1; x += 2)
 			{
@@ -36,6 +67,7 @@ namespace gl3
 					}
 				}
 			}
+			updateMatrices();
 		}
 
 		/// <summary>
@@ -105,5 +137,80 @@ namespace gl3
 		{
 			return m_halfUnitCube;
 		}
+
+		/// <summary>
+		/// Gets a plane of the view frustum in world coordinate system. The plane (a, b, c, d) contains the points
+		/// p such as a*p.x+b*p.y+c*p.z+d = 0, (a, b, c) is the unit normal oriented toward the inside of the frustum.
+		/// Planes are ordered as follows: left, right, bottom, top, near, far.
+		/// </summary>
+		/// <param name="index">The index of the plane (in [0;6[).</param>
+		/// <returns></returns>
+		const glm::vec4 & getPlane(int index) const
+		{
+			assert(index >= 0 && index < 6 && "ViewFrustum::getPlane: invalid plane index");
+			return m_planes[index];
+		}
+
+		/// <summary>
+		/// Determines whether a sphere intersects the view frustum (the test is conservative near the edges
+		/// of the frustum).
+		/// </summary>
+		/// <param name="center">The center of the sphere (world coordinate system).</param>
+		/// <param name="radius">The radius of the sphere (0 to test a point).</param>
+		/// <returns>
+		///   <c>true</c> if the sphere may be visible; otherwise, <c>false</c>.
+		/// </returns>
+		bool intersects(const glm::vec3 & center, float radius = 0.0f) const
+		{
+			for (int cpt = 0; cpt < 6; ++cpt)
+			{
+				const glm::vec4 & plane = m_planes[cpt];
+				if (plane.x*center.x + plane.y*center.y + plane.z*center.z + plane.w < -radius) { return false; }
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Determines whether a bounding box intersects the view frustum. For each plane, the vertex of the
+		/// box the farthest along the normal is tested (the test is conservative near the edges of the frustum).
+		/// </summary>
+		/// <param name="box">The bounding box (world coordinate system).</param>
+		/// <returns>
+		///   <c>true</c> if the box may be visible; otherwise, <c>false</c>.
+		/// </returns>
+		bool intersects(const BoundingBox & box) const
+		{
+			if (box.isEmpty()) { return false; }
+			for (int cpt = 0; cpt < 6; ++cpt)
+			{
+				const glm::vec4 & plane = m_planes[cpt];
+				glm::vec3 vertex(plane.x >= 0.0f ? box.max().x : box.min().x,
+					plane.y >= 0.0f ? box.max().y : box.min().y,
+					plane.z >= 0.0f ? box.max().z : box.min().z);
+				if (plane.x*vertex.x + plane.y*vertex.y + plane.z*vertex.z + plane.w < 0.0f) { return false; }
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Determines whether a bounding box is fully contained in the view frustum.
+		/// </summary>
+		/// <param name="box">The bounding box (world coordinate system).</param>
+		/// <returns>
+		///   <c>true</c> if the box is inside the frustum; otherwise, <c>false</c>.
+		/// </returns>
+		bool contains(const BoundingBox & box) const
+		{
+			if (box.isEmpty()) { return false; }
+			for (int cpt = 0; cpt < 6; ++cpt)
+			{
+				const glm::vec4 & plane = m_planes[cpt];
+				glm::vec3 vertex(plane.x >= 0.0f ? box.min().x : box.max().x,
+					plane.y >= 0.0f ? box.min().y : box.max().y,
+					plane.z >= 0.0f ? box.min().z : box.max().z);
+				if (plane.x*vertex.x + plane.y*vertex.y + plane.z*vertex.z + plane.w < 0.0f) { return false; }
+			}
+			return true;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include <Animation/ParticleSystem.h>
+#include <tbb/task_arena.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Headless throughput benchmark of Animation::ParticleSystem (no GLUT, no OpenGL context).
+// Usage: ParticleBenchmark [steps] [budget...]
+// Each budget is run serially (task arena of one thread) and in parallel. The system is fed by a
+// BallFlowEmitter sized to saturate the budget, particles are updated by the built-in modifiers and
+// killed by deathLifeTime. After a warm up reaching the steady state, the update is split in three
+// phases (modifiers, death / compaction, emission) timed through markers inserted in the system.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	/// \brief	Number of calls to the global operator new.
+	::std::atomic<size_t> s_allocations(0) ;
+
+	typedef ::std::chrono::high_resolution_clock Clock ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \struct	PhaseTimes
+	///
+	/// \brief	Time stamps of the phases of an update, written by the markers.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct PhaseTimes
+	{
+		Clock::time_point m_modifiersBegin ;
+		Clock::time_point m_modifiersEnd ;
+		Clock::time_point m_emissionBegin ;
+		Clock::time_point m_emissionEnd ;
+		size_t m_emitted ;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \struct	BenchmarkResult
+	///
+	/// \brief	Accumulated measures of a benchmark run.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct BenchmarkResult
+	{
+		double m_modifiers ;
+		double m_death ;
+		double m_emission ;
+		double m_total ;
+		size_t m_updated ;
+		size_t m_emitted ;
+		size_t m_allocations ;
+		size_t m_steps ;
+
+		BenchmarkResult()
+			: m_modifiers(0.0), m_death(0.0), m_emission(0.0), m_total(0.0), m_updated(0), m_emitted(0), m_allocations(0), m_steps(0)
+		{}
+	};
+
+	inline double seconds(Clock::time_point begin, Clock::time_point end)
+	{
+		return ::std::chrono::duration<double>(end-begin).count() ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	BenchmarkResult run(size_t budget, size_t steps, bool parallel)
+	///
+	/// \brief	Runs the benchmark for a given budget.
+	///
+	/// \author	F. Lamarche, Universit de Rennes 1
+	/// \date	18/10/2026
+	///
+	/// \param	budget  	The particle budget.
+	/// \param	steps   	The number of measured updates.
+	/// \param	parallel	true to use the parallel modifiers.
+	///
+	/// \return	The measures.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	BenchmarkResult run(size_t budget, size_t steps, bool parallel)
+	{
+		const float dt = 1.0f/60.0f ;
+		const Math::Interval<float> lifeTime(1.0f, 2.0f) ;
+		// The emission rate saturates the budget (the mean life time is lifeTime.middle())
+		const float rate = 1.2f*float(budget)/lifeTime.middle() ;
+		Animation::ParticleSystem system((unsigned int)budget) ;
+		PhaseTimes times ;
+		system.addSystemModifier([&times](Animation::ParticleSystem::ConstParticleRange, float) { times.m_modifiersBegin = Clock::now() ; }) ;
+		system.addModifier(Animation::ParticleSystem::modifierResetForce, parallel) ;
+		system.addModifier([](Animation::Particle & particle, float) { particle.m_forces = particle.m_forces+Math::makeVector(0.0f, 0.0f, -9.81f)*particle.m_mass ; }, parallel) ;
+		system.addModifier(Animation::ParticleSystem::modifierIntegrator, parallel) ;
+		system.addModifier(Animation::ParticleSystem::modifierLifeTime, parallel) ;
+		system.addModifier(Animation::ParticleSystem::ModifierColorLifeTime(HelperGl::Color(1.0f, 1.0f, 0.0f), HelperGl::Color(1.0f, 0.0f, 0.0f)), parallel) ;
+		system.addSystemModifier([&times](Animation::ParticleSystem::ConstParticleRange, float) { times.m_modifiersEnd = Clock::now() ; }) ;
+		system.addDeathFunction(Animation::ParticleSystem::deathLifeTime) ;
+		Animation::ParticleSystem::BallFlowEmitter emitter(Math::makeVector(0.0f, 0.0f, 0.0f), 1.0f, rate, Math::Interval<float>(1.0f, 5.0f), lifeTime, 1) ;
+		system.addEmitter([&times, emitter](Animation::ParticleSystem::ParticleAllocator & allocator, float dt) mutable
+		{
+			times.m_emissionBegin = Clock::now() ;
+			size_t before = allocator.productionLimit() ;
+			bool result = emitter(allocator, dt) ;
+			times.m_emitted = before-allocator.productionLimit() ;
+			times.m_emissionEnd = Clock::now() ;
+			return result ;
+		}) ;
+		// Warm up: steady state after the longest life time
+		for(float time=0.0f ; time<lifeTime.sup()+0.5f ; time+=0.1f) { system.update(0.1f) ; }
+		BenchmarkResult result ;
+		for(size_t step=0 ; step<steps ; ++step)
+		{
+			size_t updated = system.getParticles().size() ;
+			size_t allocations = s_allocations.load() ;
+			Clock::time_point begin = Clock::now() ;
+			system.update(dt) ;
+			Clock::time_point end = Clock::now() ;
+			result.m_allocations += s_allocations.load()-allocations ;
+			result.m_total += seconds(begin, end) ;
+			result.m_modifiers += seconds(times.m_modifiersBegin, times.m_modifiersEnd) ;
+			result.m_death += seconds(times.m_modifiersEnd, times.m_emissionBegin) ;
+			result.m_emission += seconds(times.m_emissionBegin, times.m_emissionEnd) ;
+			result.m_updated += updated ;
+			result.m_emitted += times.m_emitted ;
+			++result.m_steps ;
+		}
+		return result ;
+	}
+
+	void print(size_t budget, const char * mode, const BenchmarkResult & result)
+	{
+		const double steps = double(result.m_steps) ;
+		::std::printf("%10zu %-9s %14.3e %12.3f %12.3f %12.3f %12.2f %12.2f %10.1f\n", budget, mode,
+			double(result.m_updated)/result.m_total,
+			result.m_modifiers*1000.0/steps, result.m_death*1000.0/steps, result.m_emission*1000.0/steps,
+			result.m_death*1e9/::std::max(double(result.m_updated), 1.0),
+			result.m_emission*1e9/::std::max(double(result.m_emitted), 1.0),
+			double(result.m_allocations)/steps) ;
+	}
+}
+
+void * operator new(size_t size)
+{
+	++s_allocations ;
+	if(void * result = ::std::malloc(size ? size : 1)) { return result ; }
+	throw ::std::bad_alloc() ;
+}
+
+void operator delete(void * pointer) noexcept
+{
+	::std::free(pointer) ;
+}
+
+void operator delete(void * pointer, size_t) noexcept
+{
+	::std::free(pointer) ;
+}
+
+int main(int argc, char ** argv)
+{
+	size_t steps = 100 ;
+	::std::vector<size_t> budgets = { 10000, 100000, 1000000, 10000000 } ;
+	if(argc>1) { steps = ::std::max<size_t>(::std::strtoul(argv[1], nullptr, 10), 1) ; }
+	if(argc>2)
+	{
+		budgets.clear() ;
+		for(int cpt=2 ; cpt<argc ; ++cpt) { budgets.push_back(::std::strtoul(argv[cpt], nullptr, 10)) ; }
+	}
+	::std::printf("%10s %-9s %14s %12s %12s %12s %12s %12s %10s\n", "budget", "mode", "particles/s", "modif ms", "death ms", "emit ms", "death ns/p", "emit ns/p", "allocs") ;
+	for(size_t budget : budgets)
+	{
+		::tbb::task_arena serial(1) ;
+		BenchmarkResult serialResult ;
+		serial.execute([&serialResult, budget, steps]() { serialResult = run(budget, steps, false) ; }) ;
+		print(budget, "serial", serialResult) ;
+		BenchmarkResult parallelResult = run(budget, steps, true) ;
+		print(budget, "parallel", parallelResult) ;
+	}
+	return 0 ;
+}
\ No newline at end of file